@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <container/bvector.hpp>
+#include <random>
+#include <vector>
+
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+#include <boost/dynamic_bitset.hpp>
+#endif
+
+/*
+ * Whole-vector AND and shift of bit vectors with the argument's number of
+ * bits: container::vector<bool>'s word operators next to the per-bit loop
+ * they replace, std::vector<bool>, which has no such operators, and
+ * boost::dynamic_bitset when Boost is available.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+template <typename Bits>
+Bits RandomBits(size_t n, unsigned seed) {
+    std::mt19937 generator(seed);
+    Bits bits(n);
+    for (size_t i = 0; i < n; ++i) {
+        bits[i] = generator() & 1;
+    }
+    return bits;
+}
+
+void BM_BitAnd_Words(benchmark::State& state) {
+    auto lhs = RandomBits<container::vector<bool>>(state.range(0), 1);
+    const auto rhs = RandomBits<container::vector<bool>>(state.range(0), 2);
+    for (auto _ : state) {
+        lhs &= rhs;
+        benchmark::DoNotOptimize(lhs.words());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+template <typename Bits>
+void BM_BitAnd_PerBit(benchmark::State& state) {
+    auto lhs = RandomBits<Bits>(state.range(0), 1);
+    const auto rhs = RandomBits<Bits>(state.range(0), 2);
+    for (auto _ : state) {
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] = lhs[i] && rhs[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+void BM_BitShift_Words(benchmark::State& state) {
+    auto bits = RandomBits<container::vector<bool>>(state.range(0), 1);
+    for (auto _ : state) {
+        bits <<= 3;
+        bits >>= 3;
+        benchmark::DoNotOptimize(bits.words());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 4);
+}
+
+template <typename Bits>
+void BM_BitShift_PerBit(benchmark::State& state) {
+    auto bits = RandomBits<Bits>(state.range(0), 1);
+    const size_t n = bits.size();
+    for (auto _ : state) {
+        for (size_t i = n; i-- > 3;) {
+            bits[i] = bool(bits[i - 3]);
+        }
+        bits[0] = bits[1] = bits[2] = false;
+        for (size_t i = 0; i + 3 < n; ++i) {
+            bits[i] = bool(bits[i + 3]);
+        }
+        bits[n - 1] = bits[n - 2] = bits[n - 3] = false;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 4);
+}
+
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+void BM_BitAnd_Boost(benchmark::State& state) {
+    auto lhs = RandomBits<boost::dynamic_bitset<uint64_t>>(state.range(0), 1);
+    const auto rhs =
+        RandomBits<boost::dynamic_bitset<uint64_t>>(state.range(0), 2);
+    for (auto _ : state) {
+        lhs &= rhs;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+void BM_BitShift_Boost(benchmark::State& state) {
+    auto bits = RandomBits<boost::dynamic_bitset<uint64_t>>(state.range(0), 1);
+    for (auto _ : state) {
+        bits <<= 3;
+        bits >>= 3;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 4);
+}
+#endif
+
+}  // namespace
+
+BENCHMARK(BM_BitAnd_Words)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitAnd_PerBit<container::vector<bool>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitAnd_PerBit<std::vector<bool>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitShift_Words)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitShift_PerBit<container::vector<bool>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitShift_PerBit<std::vector<bool>>)->Range(1 << 10, 1 << 20);
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+BENCHMARK(BM_BitAnd_Boost)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitShift_Boost)->Range(1 << 10, 1 << 20);
+#endif
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/bvector.hpp>
+#include <vector>
+
+/*
+ * Setting and copying a range of the argument's number of bits that
+ * starts and ends inside a word: container::vector<bool>'s range
+ * operations next to a per-bit loop and to libstdc++'s std::fill and
+ * std::copy on std::vector<bool>, which work on words too.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+void BM_BitSet_Range(benchmark::State& state) {
+    container::vector<bool> bits(state.range(0) + 10);
+    for (auto _ : state) {
+        bits.set(3, bits.size() - 7);
+        benchmark::DoNotOptimize(bits.words());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+void BM_BitSet_PerBit(benchmark::State& state) {
+    container::vector<bool> bits(state.range(0) + 10);
+    for (auto _ : state) {
+        for (size_t i = 3; i < bits.size() - 7; ++i) {
+            bits[i] = true;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+void BM_BitSet_StdFill(benchmark::State& state) {
+    std::vector<bool> bits(state.range(0) + 10);
+    for (auto _ : state) {
+        std::fill(bits.begin() + 3, bits.end() - 7, true);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+template <size_t Shift>
+void BM_BitCopy_Range(benchmark::State& state) {
+    const container::vector<bool> src(state.range(0) + 10, true);
+    container::vector<bool> dst(state.range(0) + 10);
+    for (auto _ : state) {
+        dst.copy_bits(src, 3, 3 + Shift, state.range(0));
+        benchmark::DoNotOptimize(dst.words());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+template <size_t Shift>
+void BM_BitCopy_StdCopy(benchmark::State& state) {
+    const std::vector<bool> src(state.range(0) + 10, true);
+    std::vector<bool> dst(state.range(0) + 10);
+    for (auto _ : state) {
+        std::copy(src.begin() + 3, src.begin() + 3 + state.range(0),
+                  dst.begin() + 3 + Shift);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) / 8);
+}
+
+}  // namespace
+
+BENCHMARK(BM_BitSet_Range)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitSet_PerBit)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitSet_StdFill)->Range(1 << 10, 1 << 20);
+// the same offset in the source and destination words, and another one
+BENCHMARK(BM_BitCopy_Range<0>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitCopy_Range<5>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitCopy_StdCopy<0>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_BitCopy_StdCopy<5>)->Range(1 << 10, 1 << 20);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <container/bvector.hpp>
+#include <random>
+
+/*
+ * Counting the set bits of a container::vector<bool> and visiting them in
+ * order, with the word-at-a-time count() and find_next() and with the
+ * per-bit loops they replace. One bit in the argument is set, at random.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+container::vector<bool> SparseBits(size_t one_in) {
+    std::mt19937 generator(42);
+    container::vector<bool> bits(1 << 20);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = generator() % one_in == 0;
+    }
+    return bits;
+}
+
+void BM_BitCount_Words(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bits.count());
+    }
+    state.SetBytesProcessed(state.iterations() * bits.size() / 8);
+}
+
+void BM_BitCount_PerBit(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    for (auto _ : state) {
+        size_t set = 0;
+        for (bool bit : bits) {
+            set += bit;
+        }
+        benchmark::DoNotOptimize(set);
+    }
+    state.SetBytesProcessed(state.iterations() * bits.size() / 8);
+}
+
+void BM_BitFindNext_Words(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = bits.find_first(); i != bits.npos;
+             i = bits.find_next(i)) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bits.size() / 8);
+}
+
+void BM_BitFindNext_PerBit(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < bits.size(); ++i) {
+            if (bits[i]) {
+                sum += i;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * bits.size() / 8);
+}
+
+}  // namespace
+
+BENCHMARK(BM_BitCount_Words)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BitCount_PerBit)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BitFindNext_Words)->Arg(2)->Arg(64)->Arg(4096);
+BENCHMARK(BM_BitFindNext_PerBit)->Arg(2)->Arg(64)->Arg(4096);
+
+}  // namespace cpp::common::benchmarks
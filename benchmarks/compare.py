@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON reports and flags regressions.
+
+Both files come from runs of cpp_benchmarks with
+--benchmark_out=<file> --benchmark_out_format=json, e.g. through the
+benchmark_json target. Benchmarks are matched by name; with repetitions the
+mean aggregate is used. A benchmark regressed when the contender's time is
+more than --threshold percent above the baseline's. The exit code is 1 if
+any benchmark regressed, so the script can gate CI.
+
+    compare.py baseline.json contender.json --threshold 5
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    """Returns {benchmark name: time in ns} for one report."""
+    with open(path) as report:
+        benchmarks = json.load(report)["benchmarks"]
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    times = {}
+    has_means = any(b.get("aggregate_name") == "mean" for b in benchmarks)
+    for benchmark in benchmarks:
+        if benchmark.get("error_occurred"):
+            continue
+        if has_means:
+            if benchmark.get("aggregate_name") != "mean":
+                continue
+            name = benchmark["run_name"]
+        else:
+            if benchmark.get("run_type") == "aggregate":
+                continue
+            name = benchmark["name"]
+        unit = scale[benchmark.get("time_unit", "ns")]
+        times[name] = benchmark[metric] * unit
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="allowed slowdown in percent (default 5)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"],
+                        default="cpu_time")
+    parser.add_argument("--filter", default="",
+                        help="only compare benchmarks containing this text")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+    names = [name for name in baseline
+             if name in contender and args.filter in name]
+    if not names:
+        print("no benchmarks in common", file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in names)
+    print("{:<{}}  {:>12}  {:>12}  {:>8}".format(
+        "benchmark", width, "baseline ns", "contender ns", "change"))
+    regressions = []
+    for name in names:
+        before, after = baseline[name], contender[name]
+        change = (after - before) / before * 100 if before else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        print("{:<{}}  {:>12.1f}  {:>12.1f}  {:>+7.1f}%{}".format(
+            name, width, before, after, change, flag))
+
+    missing = sorted(set(baseline) - set(contender))
+    if missing:
+        print("\nnot in contender: " + ", ".join(missing))
+    if regressions:
+        print("\n{} of {} benchmarks regressed by more than {}%".format(
+            len(regressions), len(names), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
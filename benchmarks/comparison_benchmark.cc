@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/vector.hpp>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+// operator== as it was: one element at a time through operator!=.
+template <typename T>
+bool LoopEqual(const container::vector<T>& lhs,
+               const container::vector<T>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Two equal vectors, the worst case for every comparison.
+template <typename T>
+std::pair<container::vector<T>, container::vector<T>> MakePair(
+    benchmark::State& state) {
+    container::vector<T> lhs(state.range(0));
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        lhs[i] = T(i);
+    }
+    return {lhs, lhs};
+}
+
+template <typename T>
+void BM_Equal_Loop(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LoopEqual(lhs, rhs));
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+template <typename T>
+void BM_Equal_Operator(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+template <typename T>
+void BM_Less_Loop(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lexicographical_compare(
+            lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+template <typename T>
+void BM_Less_Operator(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+template <typename T>
+void BM_Mismatch_Std(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::mismatch(lhs.data(), lhs.data() + lhs.size(), rhs.data()));
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+template <typename T>
+void BM_Mismatch_Simd(benchmark::State& state) {
+    auto [lhs, rhs] = MakePair<T>(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(container::mismatch(lhs, rhs));
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(T));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Equal_Loop<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Equal_Operator<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Equal_Loop<double>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Equal_Operator<double>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Less_Loop<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Less_Operator<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Mismatch_Std<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Mismatch_Simd<int>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Mismatch_Std<unsigned char>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Mismatch_Simd<unsigned char>)->Range(1 << 6, 1 << 18);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/concurrent_vector.hpp>
+#include <container/vector.hpp>
+#include <mutex>
+#include <thread>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+const int kMaxThreads =
+    std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+
+// Shared by all threads of one run; thread 0 creates and destroys it, the
+// loop's start and end barriers keep the others out in between.
+container::concurrent_vector<long>* concurrentShared;
+container::vector<long>* lockedShared;
+std::mutex lockedMutex;
+
+void BM_Append_ConcurrentVector(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        concurrentShared = new container::concurrent_vector<long>();
+    }
+    long value = 0;
+    for (auto _ : state) {
+        concurrentShared->push_back(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete concurrentShared;
+    }
+}
+
+// What the workers do today: one mutex around a plain vector.
+void BM_Append_MutexVector(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        lockedShared = new container::vector<long>();
+    }
+    long value = 0;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(lockedMutex);
+        lockedShared->push_back(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete lockedShared;
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Append_ConcurrentVector)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_Append_MutexVector)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+#include <container/bvector.hpp>
+#include <container/vector.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+#include <boost/container/vector.hpp>
+#include <boost/dynamic_bitset.hpp>
+#endif
+
+/*
+ * container::vector and vector<bool> next to std::vector and, when Boost
+ * is installed, boost::container::vector and boost::dynamic_bitset, on the
+ * basic operations. Run with --benchmark_out=<file>.json
+ * --benchmark_out_format=json (or build the benchmark_json target) and
+ * compare two runs with benchmarks/compare.py.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+typedef container::vector<int> ContainerInts;
+typedef std::vector<int> StdInts;
+typedef container::vector<bool> ContainerBits;
+typedef std::vector<bool> StdBits;
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+typedef boost::container::vector<int> BoostInts;
+typedef boost::dynamic_bitset<> BoostBits;
+#endif
+
+template <typename Vector>
+struct element {
+    typedef typename Vector::value_type type;
+};
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+template <>
+struct element<BoostBits> {
+    typedef bool type;
+};
+#endif
+template <typename Vector>
+using Element = typename element<Vector>::type;
+
+template <typename Vector>
+Vector MakeFilled(size_t n) {
+    Vector vec;
+    for (size_t i = 0; i < n; ++i) {
+        vec.push_back(Element<Vector>(i & 1));
+    }
+    return vec;
+}
+
+// Indices in a fixed pseudo-random order so that every run reads the same.
+std::vector<uint32_t> RandomIndices(size_t n) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32_t> distribution(0, n - 1);
+    std::vector<uint32_t> indices(n);
+    for (auto& index : indices) {
+        index = distribution(generator);
+    }
+    return indices;
+}
+
+template <typename Vector>
+void BM_PushBack(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector vec;
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(Element<Vector>(i & 1));
+        }
+        benchmark::DoNotOptimize(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_PushBackReserved(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector vec;
+        vec.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(Element<Vector>(i & 1));
+        }
+        benchmark::DoNotOptimize(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_RandomRead(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const Vector vec = MakeFilled<Vector>(n);
+    const std::vector<uint32_t> indices = RandomIndices(n);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (uint32_t index : indices) {
+            sum += vec[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_RandomWrite(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    Vector vec = MakeFilled<Vector>(n);
+    const std::vector<uint32_t> indices = RandomIndices(n);
+    for (auto _ : state) {
+        for (uint32_t index : indices) {
+            vec[index] = !vec[index];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Sequential reads by index; bit containers pay for the bit extraction.
+template <typename Vector>
+void BM_Scan(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const Vector vec = MakeFilled<Vector>(n);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += vec[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_Iterate(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const Vector vec = MakeFilled<Vector>(n);
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (auto value : vec) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_Copy(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const Vector vec = MakeFilled<Vector>(n);
+    for (auto _ : state) {
+        Vector copy(vec);
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+void BM_Move(benchmark::State& state) {
+    Vector vec = MakeFilled<Vector>(state.range(0));
+    for (auto _ : state) {
+        Vector moved(std::move(vec));
+        vec = std::move(moved);
+        benchmark::DoNotOptimize(vec);
+    }
+}
+
+}  // namespace
+
+#define CONTAINER_BENCHMARK(name, type) \
+    BENCHMARK_TEMPLATE(name, type)->Range(1 << 6, 1 << 18)
+
+CONTAINER_BENCHMARK(BM_PushBack, ContainerInts);
+CONTAINER_BENCHMARK(BM_PushBack, StdInts);
+CONTAINER_BENCHMARK(BM_PushBackReserved, ContainerInts);
+CONTAINER_BENCHMARK(BM_PushBackReserved, StdInts);
+CONTAINER_BENCHMARK(BM_RandomRead, ContainerInts);
+CONTAINER_BENCHMARK(BM_RandomRead, StdInts);
+CONTAINER_BENCHMARK(BM_Iterate, ContainerInts);
+CONTAINER_BENCHMARK(BM_Iterate, StdInts);
+CONTAINER_BENCHMARK(BM_Copy, ContainerInts);
+CONTAINER_BENCHMARK(BM_Copy, StdInts);
+CONTAINER_BENCHMARK(BM_Move, ContainerInts);
+CONTAINER_BENCHMARK(BM_Move, StdInts);
+
+CONTAINER_BENCHMARK(BM_PushBack, ContainerBits);
+CONTAINER_BENCHMARK(BM_PushBack, StdBits);
+CONTAINER_BENCHMARK(BM_RandomRead, ContainerBits);
+CONTAINER_BENCHMARK(BM_RandomRead, StdBits);
+CONTAINER_BENCHMARK(BM_RandomWrite, ContainerBits);
+CONTAINER_BENCHMARK(BM_RandomWrite, StdBits);
+CONTAINER_BENCHMARK(BM_Scan, ContainerBits);
+CONTAINER_BENCHMARK(BM_Scan, StdBits);
+CONTAINER_BENCHMARK(BM_Copy, ContainerBits);
+CONTAINER_BENCHMARK(BM_Copy, StdBits);
+
+#if defined(CPP_BENCHMARK_HAVE_BOOST)
+CONTAINER_BENCHMARK(BM_PushBack, BoostInts);
+CONTAINER_BENCHMARK(BM_PushBackReserved, BoostInts);
+CONTAINER_BENCHMARK(BM_RandomRead, BoostInts);
+CONTAINER_BENCHMARK(BM_Iterate, BoostInts);
+CONTAINER_BENCHMARK(BM_Copy, BoostInts);
+CONTAINER_BENCHMARK(BM_Move, BoostInts);
+CONTAINER_BENCHMARK(BM_PushBack, BoostBits);
+CONTAINER_BENCHMARK(BM_RandomRead, BoostBits);
+CONTAINER_BENCHMARK(BM_RandomWrite, BoostBits);
+CONTAINER_BENCHMARK(BM_Scan, BoostBits);
+CONTAINER_BENCHMARK(BM_Copy, BoostBits);
+#endif
+
+}  // namespace cpp::common::benchmarks
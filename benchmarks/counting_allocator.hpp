@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <container/allocator.hpp>
+
+namespace cpp::common::benchmarks {
+
+struct allocation_counters {
+    size_t allocations = 0;
+    size_t reallocations = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+
+    void reset() { *this = allocation_counters(); }
+    void add(size_t bytes) {
+        live_bytes += bytes;
+        peak_bytes = std::max(peak_bytes, live_bytes);
+    }
+};
+
+inline allocation_counters& counters() {
+    static allocation_counters instance;
+    return instance;
+}
+
+/*
+ * malloc_allocator that records calls and bytes in counters(). Realloc
+ * toggles whether containers see the reallocate() extension; the peak of
+ * live bytes stands in for peak RSS of the container.
+ */
+template <typename T, bool Realloc = true>
+struct counting_allocator : container::malloc_allocator<T> {
+    template <typename U>
+    struct rebind {
+        typedef counting_allocator<U, Realloc> other;
+    };
+
+    counting_allocator() = default;
+    template <typename U>
+    counting_allocator(const counting_allocator<U, Realloc>&) noexcept {}
+
+    T* allocate(size_t n) {
+        counters().allocations++;
+        counters().add(n * sizeof(T));
+        return container::malloc_allocator<T>::allocate(n);
+    }
+    void deallocate(T* pointer, size_t n) noexcept {
+        counters().live_bytes -= n * sizeof(T);
+        container::malloc_allocator<T>::deallocate(pointer, n);
+    }
+    T* reallocate(T* pointer, size_t old_n, size_t new_n) requires Realloc {
+        counters().reallocations++;
+        counters().live_bytes -= old_n * sizeof(T);
+        counters().add(new_n * sizeof(T));
+        return container::malloc_allocator<T>::reallocate(pointer, old_n,
+                                                          new_n);
+    }
+};
+
+}  // namespace cpp::common::benchmarks
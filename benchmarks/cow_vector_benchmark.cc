@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <container/cow_vector.hpp>
+#include <container/vector.hpp>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+constexpr size_t kElements = 1 << 20;
+
+/*
+ * The cost of handing a reader its own copy of a 1M element table: a deep
+ * copy, a cow_vector copy and a snapshot of an atomic_cow_vector.
+ */
+void BM_Snapshot_DeepCopy(benchmark::State& state) {
+    const container::vector<long> table(kElements, 1);
+    for (auto _ : state) {
+        container::vector<long> copy(table);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+void BM_Snapshot_CowCopy(benchmark::State& state) {
+    const container::cow_vector<long> table(
+        container::vector<long>(kElements, 1));
+    for (auto _ : state) {
+        container::cow_vector<long> copy(table);
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+void BM_Snapshot_AtomicLoad(benchmark::State& state) {
+    container::atomic_cow_vector<long> published(
+        container::cow_vector<long>(container::vector<long>(kElements, 1)));
+    for (auto _ : state) {
+        auto snapshot = published.load();
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+}
+
+// The deferred price: the first write to a shared copy clones the table.
+void BM_Snapshot_CowFirstWrite(benchmark::State& state) {
+    const container::cow_vector<long> table(
+        container::vector<long>(kElements, 1));
+    for (auto _ : state) {
+        container::cow_vector<long> copy(table);
+        copy.edit()[0] = 2;
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_Snapshot_DeepCopy);
+BENCHMARK(BM_Snapshot_CowCopy);
+BENCHMARK(BM_Snapshot_AtomicLoad);
+BENCHMARK(BM_Snapshot_CowFirstWrite);
+
+}  // namespace cpp::common::benchmarks
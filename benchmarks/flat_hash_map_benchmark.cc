@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <container/flat_hash_map.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Point lookups in flat_hash_map and std::unordered_map holding the same
+ * keys at the same load factor, given in percent by the argument. Both
+ * tables have 2^16 slots or buckets; Hit probes keys that are present,
+ * Miss keys that are not, both in random order.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+constexpr size_t kSlots = size_t(1) << 16;
+
+// Random even keys are present, their odd neighbours are not.
+struct Keys {
+    explicit Keys(size_t n) {
+        std::mt19937_64 generator(42);
+        for (size_t i = 0; i < n; ++i) {
+            present.push_back(generator() & ~uint64_t(1));
+        }
+        for (uint64_t key : present) {
+            absent.push_back(key | 1);
+        }
+        std::shuffle(present.begin(), present.end(), generator);
+    }
+    std::vector<uint64_t> present;
+    std::vector<uint64_t> absent;
+};
+
+template <typename Map>
+Map MakeMap(const std::vector<uint64_t>& keys);
+
+template <>
+container::flat_hash_map<uint64_t, uint64_t> MakeMap(
+    const std::vector<uint64_t>& keys) {
+    container::flat_hash_map<uint64_t, uint64_t> map;
+    map.reserve(kSlots * 7 / 8);
+    for (uint64_t key : keys) {
+        map.try_emplace(key, key);
+    }
+    return map;
+}
+
+template <>
+std::unordered_map<uint64_t, uint64_t> MakeMap(
+    const std::vector<uint64_t>& keys) {
+    std::unordered_map<uint64_t, uint64_t> map;
+    map.max_load_factor(1);
+    map.rehash(kSlots);
+    for (uint64_t key : keys) {
+        map.try_emplace(key, key);
+    }
+    return map;
+}
+
+template <typename Map, bool Hit>
+void BM_HashLookup(benchmark::State& state) {
+    const Keys keys(kSlots * state.range(0) / 100);
+    const Map map = MakeMap<Map>(keys.present);
+    const auto& probes = Hit ? keys.present : keys.absent;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto it = map.find(probes[i]);
+        benchmark::DoNotOptimize(it == map.end() ? 0 : it->second);
+        i = i + 1 == probes.size() ? 0 : i + 1;
+    }
+    state.counters["load_factor"] = map.load_factor();
+}
+
+typedef container::flat_hash_map<uint64_t, uint64_t> FlatHashMap;
+typedef std::unordered_map<uint64_t, uint64_t> UnorderedMap;
+
+}  // namespace
+
+BENCHMARK(BM_HashLookup<FlatHashMap, true>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_HashLookup<UnorderedMap, true>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_HashLookup<FlatHashMap, false>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_HashLookup<UnorderedMap, false>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+
+}  // namespace cpp::common::benchmarks
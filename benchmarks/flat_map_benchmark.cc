@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <container/flat_map.hpp>
+#include <container/flat_set.hpp>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+/*
+ * Lookups in read-mostly tables of a few thousand entries: flat_map next
+ * to std::map, and the branchless search of flat_set next to
+ * std::lower_bound over the same sorted array. Build compares a bulk
+ * insert of shuffled entries with inserting them one by one into std::map.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+// Even keys 0, 2, ..., 2n - 2 in random order.
+std::vector<uint64_t> ShuffledKeys(size_t n) {
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = 2 * i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    return keys;
+}
+
+// Half of them present, in an order the branch predictor cannot learn.
+std::vector<uint64_t> Probes(size_t n) {
+    std::vector<uint64_t> probes(4096);
+    std::mt19937 generator(7);
+    for (auto& probe : probes) {
+        probe = generator() % (2 * n);
+    }
+    return probes;
+}
+
+template <typename Map>
+Map MakeMap(size_t n) {
+    Map map;
+    for (uint64_t key : ShuffledKeys(n)) {
+        map.insert({key, key});
+    }
+    return map;
+}
+
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+    const Map map = MakeMap<Map>(state.range(0));
+    const auto probes = Probes(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        auto it = map.find(probes[i++ & (probes.size() - 1)]);
+        benchmark::DoNotOptimize(it != map.end() ? it->second : 0);
+    }
+}
+
+void BM_SetFind_FlatSet(benchmark::State& state) {
+    const auto keys = ShuffledKeys(state.range(0));
+    const container::flat_set<uint64_t> set(keys.begin(), keys.end());
+    const auto probes = Probes(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            set.contains(probes[i++ & (probes.size() - 1)]));
+    }
+}
+
+void BM_SetFind_LowerBound(benchmark::State& state) {
+    auto keys = ShuffledKeys(state.range(0));
+    std::sort(keys.begin(), keys.end());
+    const auto probes = Probes(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        const uint64_t probe = probes[i++ & (probes.size() - 1)];
+        auto it = std::lower_bound(keys.begin(), keys.end(), probe);
+        benchmark::DoNotOptimize(it != keys.end() && *it == probe);
+    }
+}
+
+void BM_MapBuild_StdMap(benchmark::State& state) {
+    const auto keys = ShuffledKeys(state.range(0));
+    for (auto _ : state) {
+        std::map<uint64_t, uint64_t> map;
+        for (uint64_t key : keys) {
+            map.emplace(key, key);
+        }
+        benchmark::DoNotOptimize(&map);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void BM_MapBuild_FlatMap(benchmark::State& state) {
+    const auto keys = ShuffledKeys(state.range(0));
+    std::vector<std::pair<uint64_t, uint64_t>> entries;
+    for (uint64_t key : keys) {
+        entries.emplace_back(key, key);
+    }
+    for (auto _ : state) {
+        container::flat_map<uint64_t, uint64_t> map;
+        map.insert(entries.begin(), entries.end());
+        benchmark::DoNotOptimize(&map);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_MapFind<std::map<uint64_t, uint64_t>>)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_MapFind<container::flat_map<uint64_t, uint64_t>>)
+    ->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_SetFind_FlatSet)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_SetFind_LowerBound)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_MapBuild_StdMap)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_MapBuild_FlatMap)->Range(1 << 8, 1 << 14);
+
+}  // namespace cpp::common::benchmarks
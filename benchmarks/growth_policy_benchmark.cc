@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <container/vector.hpp>
+
+#include "counting_allocator.hpp"
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+struct Record {
+    double values[6];
+};
+
+/*
+ * Appends n elements one by one and reports, besides throughput, the peak
+ * of live heap bytes (the transient old + new buffer during a copy counts
+ * twice) and the slack left in the final buffer.
+ */
+template <typename T, typename Policy, bool Realloc>
+void BM_Append(benchmark::State& state) {
+    using Vector = container::vector<T, counting_allocator<T, Realloc>, Policy>;
+    const auto n = static_cast<size_t>(state.range(0));
+    size_t capacity = 0;
+    counters().reset();
+    for (auto _ : state) {
+        Vector vec;
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(T{});
+        }
+        benchmark::DoNotOptimize(vec.data());
+        capacity = vec.capacity();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["peak_bytes"] = counters().peak_bytes;
+    state.counters["slack_bytes"] = (capacity - n) * sizeof(T);
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        counters().allocations + counters().reallocations,
+        benchmark::Counter::kAvgIterations);
+}
+
+using PowerOfTwo = container::power_of_two_growth;
+using Double = container::geometric_growth<2, 1>;
+using OneAndHalf = container::geometric_growth<3, 2>;
+using SizeClass = container::size_class_growth;
+
+}  // namespace
+
+#define GROWTH_BENCHMARK(T, Policy, Realloc)                          \
+    BENCHMARK(BM_Append<T, Policy, Realloc>)                             \
+        ->Name("BM_Append_" #T "_" #Policy "_realloc_" #Realloc)      \
+        ->RangeMultiplier(10)                                         \
+        ->Range(1000, 1000000)
+
+GROWTH_BENCHMARK(int, PowerOfTwo, false);
+GROWTH_BENCHMARK(int, PowerOfTwo, true);
+GROWTH_BENCHMARK(int, Double, false);
+GROWTH_BENCHMARK(int, Double, true);
+GROWTH_BENCHMARK(int, OneAndHalf, false);
+GROWTH_BENCHMARK(int, OneAndHalf, true);
+GROWTH_BENCHMARK(int, SizeClass, false);
+GROWTH_BENCHMARK(int, SizeClass, true);
+GROWTH_BENCHMARK(Record, PowerOfTwo, false);
+GROWTH_BENCHMARK(Record, PowerOfTwo, true);
+GROWTH_BENCHMARK(Record, OneAndHalf, false);
+GROWTH_BENCHMARK(Record, OneAndHalf, true);
+GROWTH_BENCHMARK(Record, SizeClass, false);
+GROWTH_BENCHMARK(Record, SizeClass, true);
+
+}  // namespace cpp::common::benchmarks
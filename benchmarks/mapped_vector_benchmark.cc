@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <container/mapped_vector.hpp>
+#include <container/vector.hpp>
+#include <filesystem>
+#include <string>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+struct Record {
+    long id;
+    double features[7];
+};
+
+// A file of n records, written once per size and reused by every run.
+std::string RecordFile(size_t n) {
+    auto path = (std::filesystem::temp_directory_path() /
+                 ("mapped_vector_benchmark." + std::to_string(n)))
+                    .string();
+    if (!std::filesystem::exists(path) ||
+        std::filesystem::file_size(path) != n * sizeof(Record)) {
+        std::filesystem::remove(path);
+        container::mapped_vector<Record> file(path);
+        file.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            file.push_back({(long)i, {}});
+        }
+    }
+    return path;
+}
+
+// The loader the mapping replaces: read() the whole file into a vector.
+container::vector<Record> ReadIntoVector(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    const size_t bytes = std::filesystem::file_size(path);
+    container::vector<Record> records;
+    auto* buffer = (char*)records.prepare_append(bytes / sizeof(Record));
+    for (size_t done = 0; done < bytes;) {
+        ssize_t got = read(fd, buffer + done, bytes - done);
+        if (got <= 0) break;
+        done += got;
+    }
+    close(fd);
+    records.commit_append(bytes / sizeof(Record));
+    return records;
+}
+
+long SumIds(const auto& records) {
+    long sum = 0;
+    for (const auto& record : records) {
+        sum += record.id;
+    }
+    return sum;
+}
+
+void BM_Startup_ReadIntoVector(benchmark::State& state) {
+    auto path = RecordFile(state.range(0));
+    for (auto _ : state) {
+        auto records = ReadIntoVector(path);
+        benchmark::DoNotOptimize(records.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(Record));
+}
+
+void BM_Startup_Mapped(benchmark::State& state) {
+    auto path = RecordFile(state.range(0));
+    for (auto _ : state) {
+        container::mapped_vector<Record> records(
+            path, container::map_mode::read_only);
+        benchmark::DoNotOptimize(records.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(Record));
+}
+
+// Startup followed by one pass over every record, which faults in all
+// pages of the mapping.
+void BM_StartupAndScan_ReadIntoVector(benchmark::State& state) {
+    auto path = RecordFile(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SumIds(ReadIntoVector(path)));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(Record));
+}
+
+void BM_StartupAndScan_Mapped(benchmark::State& state) {
+    auto path = RecordFile(state.range(0));
+    for (auto _ : state) {
+        container::mapped_vector<Record> records(
+            path, container::map_mode::read_only);
+        benchmark::DoNotOptimize(SumIds(records));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            sizeof(Record));
+}
+
+}  // namespace
+
+BENCHMARK(BM_Startup_ReadIntoVector)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Startup_Mapped)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StartupAndScan_ReadIntoVector)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StartupAndScan_Mapped)->Range(1 << 10, 1 << 20);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/vector.hpp>
+#include <container/vector_parallel.hpp>
+#include <thread>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+constexpr size_t bytes = size_t(1) << 30;
+constexpr size_t n = bytes / sizeof(double);
+const int kMaxThreads =
+    std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+
+/*
+ * Builds a 1 GiB vector<double>, page faults included, with a pool of
+ * state.range(0) threads, next to the serial constructors. bytes_per_second
+ * is the rate at which memory gets initialized.
+ */
+void BM_ParallelFill(benchmark::State& state) {
+    container::thread_pool pool(state.range(0));
+    for (auto _ : state) {
+        container::vector<double> vec(n, 1.0, container::parallel_t(&pool));
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+void BM_SerialFill(benchmark::State& state) {
+    for (auto _ : state) {
+        container::vector<double> vec(n, 1.0);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+void BM_ParallelCopy(benchmark::State& state) {
+    container::thread_pool pool(state.range(0));
+    container::parallel_t par(&pool);
+    const container::vector<double> source(n, 1.0, par);
+    for (auto _ : state) {
+        container::vector<double> copy(source, par);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+void BM_SerialCopy(benchmark::State& state) {
+    const container::vector<double> source(n, 1.0);
+    for (auto _ : state) {
+        container::vector<double> copy(source);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SerialFill)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelFill)
+    ->RangeMultiplier(2)
+    ->Range(1, kMaxThreads)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_SerialCopy)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ParallelCopy)
+    ->RangeMultiplier(2)
+    ->Range(1, kMaxThreads)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace cpp::common::benchmarks
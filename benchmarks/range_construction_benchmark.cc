@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <container/vector.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+template <typename Source>
+Source MakeSource(size_t n) {
+    Source source;
+    for (size_t i = 0; i < n; ++i) {
+        source.push_back(typename Source::value_type(i));
+    }
+    return source;
+}
+
+// What callers had to write before the range constructor existed.
+template <typename T, typename Source>
+void BM_PushBackLoop(benchmark::State& state) {
+    const auto source = MakeSource<Source>(state.range(0));
+    for (auto _ : state) {
+        container::vector<T> vec;
+        for (const auto& ele : source) {
+            vec.push_back(ele);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+template <typename T, typename Source>
+void BM_RangeConstruct(benchmark::State& state) {
+    const auto source = MakeSource<Source>(state.range(0));
+    for (auto _ : state) {
+        container::vector<T> vec(source.begin(), source.end());
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+template <typename T, typename Source>
+void BM_AppendRange(benchmark::State& state) {
+    const auto source = MakeSource<Source>(state.range(0));
+    for (auto _ : state) {
+        container::vector<T> vec(1);
+        vec.append(source.begin(), source.end());
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_PushBackLoop<int, std::vector<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_RangeConstruct<int, std::vector<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_AppendRange<int, std::vector<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_PushBackLoop<int, std::list<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_RangeConstruct<int, std::list<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_PushBackLoop<double, std::vector<int>>)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_RangeConstruct<double, std::vector<int>>)->Range(1 << 6, 1 << 16);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <bit>
+#include <container/rank_select.hpp>
+#include <random>
+#include <vector>
+
+/*
+ * rank and select at random positions of 2^22 bits of which one in the
+ * argument is set, through rank_select_vector's index and by summing the
+ * popcounts of the words from the front, which is what answering them
+ * without an index takes.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+constexpr size_t kBits = size_t(1) << 22;
+
+container::vector<bool> SparseBits(size_t one_in) {
+    std::mt19937 generator(42);
+    container::vector<bool> bits(kBits);
+    for (size_t i = 0; i < kBits; ++i) {
+        bits[i] = generator() % one_in == 0;
+    }
+    return bits;
+}
+
+std::vector<size_t> Queries(size_t bound) {
+    std::mt19937_64 generator(7);
+    std::vector<size_t> queries(1024);
+    for (auto& query : queries) {
+        query = bound ? generator() % bound : 0;
+    }
+    return queries;
+}
+
+size_t ScanRank(const container::vector<bool>& bits, size_t n) {
+    const uint64_t* words = bits.words();
+    size_t set = 0;
+    for (size_t i = 0; i < n / 64; ++i) {
+        set += std::popcount(words[i]);
+    }
+    if (n % 64) {
+        set += std::popcount(words[n / 64] & ((uint64_t(1) << n % 64) - 1));
+    }
+    return set;
+}
+
+size_t ScanSelect(const container::vector<bool>& bits, size_t n) {
+    const uint64_t* words = bits.words();
+    size_t word = 0;
+    for (size_t set; n >= (set = std::popcount(words[word])); n -= set) {
+        ++word;
+    }
+    return word * 64 + container::detail::select_in_word(words[word], n);
+}
+
+void BM_Rank_Index(benchmark::State& state) {
+    container::rank_select_vector<> index(SparseBits(state.range(0)));
+    index.build();
+    const auto queries = Queries(kBits);
+    for (auto _ : state) {
+        for (size_t query : queries) {
+            benchmark::DoNotOptimize(index.rank(query));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void BM_Rank_Scan(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    const auto queries = Queries(kBits);
+    for (auto _ : state) {
+        for (size_t query : queries) {
+            benchmark::DoNotOptimize(ScanRank(bits, query));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void BM_Select_Index(benchmark::State& state) {
+    container::rank_select_vector<> index(SparseBits(state.range(0)));
+    const auto queries = Queries(index.count());
+    for (auto _ : state) {
+        for (size_t query : queries) {
+            benchmark::DoNotOptimize(index.select(query));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void BM_Select_Scan(benchmark::State& state) {
+    const auto bits = SparseBits(state.range(0));
+    const auto queries = Queries(bits.count());
+    for (auto _ : state) {
+        for (size_t query : queries) {
+            benchmark::DoNotOptimize(ScanSelect(bits, query));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+}  // namespace
+
+BENCHMARK(BM_Rank_Index)->Arg(2)->Arg(64);
+BENCHMARK(BM_Rank_Scan)->Arg(2)->Arg(64);
+BENCHMARK(BM_Select_Index)->Arg(2)->Arg(64);
+BENCHMARK(BM_Select_Scan)->Arg(2)->Arg(64);
+
+}  // namespace cpp::common::benchmarks
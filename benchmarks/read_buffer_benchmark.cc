@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <string.h>
+
+#include <container/vector.hpp>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+// Stands in for read(): overwrites the whole destination.
+void Produce(char* dst, size_t n) { memset(dst, 'x', n); }
+
+void BM_ReadBuffer_Resize(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        container::vector<char> buffer;
+        buffer.resize(n);
+        Produce(buffer.data(), n);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+void BM_ReadBuffer_DefaultInit(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        container::vector<char> buffer;
+        buffer.resize(n, container::default_init);
+        Produce(buffer.data(), n);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// Appends in chunks as a socket reader would.
+void BM_ReadBuffer_PrepareCommit(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const size_t chunk = 4096;
+    for (auto _ : state) {
+        container::vector<char> buffer;
+        for (size_t done = 0; done < n; done += chunk) {
+            size_t len = std::min(chunk, n - done);
+            Produce(buffer.prepare_append(len), len);
+            buffer.commit_append(len);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ReadBuffer_Resize)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_ReadBuffer_DefaultInit)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_ReadBuffer_PrepareCommit)->Range(1 << 12, 1 << 24);
+
+}  // namespace cpp::common::benchmarks
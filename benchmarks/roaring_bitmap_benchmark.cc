@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/bvector.hpp>
+#include <container/roaring_bitmap.hpp>
+#include <iterator>
+#include <random>
+#include <vector>
+
+/*
+ * Intersection and union of two sets of random values below the
+ * argument's power of two, 2^20 values each: roaring_bitmap next to a
+ * container::vector<bool> over the whole range and sorted std::vector
+ * merges.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+constexpr size_t kValues = 1 << 20;
+
+std::vector<uint32_t> RandomValues(size_t bits, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::vector<uint32_t> values(kValues);
+    for (auto& value : values) {
+        value = generator() & ((uint64_t(1) << bits) - 1);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+container::vector<bool> Bits(const std::vector<uint32_t>& values,
+                             size_t bits) {
+    container::vector<bool> result(size_t(1) << bits);
+    for (uint32_t value : values) {
+        result[value] = true;
+    }
+    return result;
+}
+
+template <bool Union>
+void BM_SetOp_Roaring(benchmark::State& state) {
+    const auto lhsValues = RandomValues(state.range(0), 1);
+    const auto rhsValues = RandomValues(state.range(0), 2);
+    const container::roaring_bitmap lhs(lhsValues.begin(), lhsValues.end());
+    const container::roaring_bitmap rhs(rhsValues.begin(), rhsValues.end());
+    for (auto _ : state) {
+        auto result = Union ? lhs | rhs : lhs & rhs;
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["bytes"] = lhs.serialized_size();
+}
+
+template <bool Union>
+void BM_SetOp_BitVector(benchmark::State& state) {
+    const auto lhs = Bits(RandomValues(state.range(0), 1), state.range(0));
+    const auto rhs = Bits(RandomValues(state.range(0), 2), state.range(0));
+    for (auto _ : state) {
+        auto result = Union ? lhs | rhs : lhs & rhs;
+        benchmark::DoNotOptimize(result.words());
+    }
+    state.counters["bytes"] = lhs.word_count() * sizeof(uint64_t);
+}
+
+template <bool Union>
+void BM_SetOp_SortedVector(benchmark::State& state) {
+    const auto lhs = RandomValues(state.range(0), 1);
+    const auto rhs = RandomValues(state.range(0), 2);
+    std::vector<uint32_t> result;
+    for (auto _ : state) {
+        result.clear();
+        if (Union) {
+            std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                           std::back_inserter(result));
+        } else {
+            std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(),
+                                  rhs.end(), std::back_inserter(result));
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["bytes"] = lhs.size() * sizeof(uint32_t);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SetOp_Roaring<false>)->Arg(22)->Arg(24)->Arg(32);
+BENCHMARK(BM_SetOp_BitVector<false>)->Arg(22)->Arg(24)->Arg(28);
+BENCHMARK(BM_SetOp_SortedVector<false>)->Arg(22)->Arg(24)->Arg(32);
+BENCHMARK(BM_SetOp_Roaring<true>)->Arg(22)->Arg(24)->Arg(32);
+BENCHMARK(BM_SetOp_BitVector<true>)->Arg(22)->Arg(24)->Arg(28);
+BENCHMARK(BM_SetOp_SortedVector<true>)->Arg(22)->Arg(24)->Arg(32);
+
+}  // namespace cpp::common::benchmarks
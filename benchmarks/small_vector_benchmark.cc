@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <container/small_vector.hpp>
+#include <container/vector.hpp>
+
+#include "counting_allocator.hpp"
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+/*
+ * Builds a per-request sized vector: reserve for the expected size, then
+ * fill it. allocs_per_op counts the trips to the allocator per vector.
+ */
+template <typename Vector>
+void BuildAndDrop(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    counters().reset();
+    for (auto _ : state) {
+        Vector vec;
+        vec.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["allocs_per_op"] =
+        benchmark::Counter(counters().allocations + counters().reallocations,
+                           benchmark::Counter::kAvgIterations);
+}
+
+void BM_BuildVector(benchmark::State& state) {
+    BuildAndDrop<container::vector<int, counting_allocator<int>>>(state);
+}
+void BM_BuildSmallVector16(benchmark::State& state) {
+    BuildAndDrop<container::small_vector<int, 16, counting_allocator<int>>>(
+        state);
+}
+
+}  // namespace
+
+BENCHMARK(BM_BuildVector)->RangeMultiplier(2)->Range(2, 64);
+BENCHMARK(BM_BuildSmallVector16)->RangeMultiplier(2)->Range(2, 64);
+
+}  // namespace cpp::common::benchmarks
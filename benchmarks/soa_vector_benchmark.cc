@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <container/soa_vector.hpp>
+#include <container/vector.hpp>
+
+namespace cpp::common::benchmarks {
+namespace {
+
+// A 64 byte record of which the scans below read one or two fields.
+struct Trade {
+    long id = 0;
+    long timestamp = 0;
+    double price = 0;
+    double quantity = 0;
+    double bid = 0;
+    double ask = 0;
+    long venue = 0;
+    long flags = 0;
+};
+
+}  // namespace
+}  // namespace cpp::common::benchmarks
+
+namespace cpp::common::reflection {
+template <>
+struct ObjectDef<benchmarks::Trade> {
+    ObjectDef() = delete;
+#define TRADE_FIELD(field)                               \
+    struct field {                                       \
+        static constexpr std::string_view View = #field; \
+    }
+    TRADE_FIELD(id);
+    TRADE_FIELD(timestamp);
+    TRADE_FIELD(price);
+    TRADE_FIELD(quantity);
+    TRADE_FIELD(bid);
+    TRADE_FIELD(ask);
+    TRADE_FIELD(venue);
+    TRADE_FIELD(flags);
+#undef TRADE_FIELD
+    static constexpr ElemList Properties = {
+        Property{id{}, &benchmarks::Trade::id},
+        Property{timestamp{}, &benchmarks::Trade::timestamp},
+        Property{price{}, &benchmarks::Trade::price},
+        Property{quantity{}, &benchmarks::Trade::quantity},
+        Property{bid{}, &benchmarks::Trade::bid},
+        Property{ask{}, &benchmarks::Trade::ask},
+        Property{venue{}, &benchmarks::Trade::venue},
+        Property{flags{}, &benchmarks::Trade::flags}};
+};
+}  // namespace cpp::common::reflection
+
+namespace cpp::common::benchmarks {
+namespace {
+
+typedef reflection::ObjectDef<Trade> TradeDef;
+
+Trade MakeTrade(size_t i) {
+    Trade trade;
+    trade.id = i;
+    trade.price = double(i % 100);
+    trade.quantity = double(i % 7);
+    return trade;
+}
+
+/*
+ * Sums the price of state.range(0) trades. The array of structs pulls all
+ * 64 bytes of every record through the cache for the 8 it needs; the
+ * struct of arrays streams the price column alone.
+ */
+void BM_SumPrice_Vector(benchmark::State& state) {
+    container::vector<Trade> trades;
+    for (long i = 0; i < state.range(0); ++i) {
+        trades.push_back(MakeTrade(i));
+    }
+    for (auto _ : state) {
+        double total = 0;
+        for (const Trade& trade : trades) {
+            total += trade.price;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SumPrice_SoaVector(benchmark::State& state) {
+    container::soa_vector<Trade> trades;
+    for (long i = 0; i < state.range(0); ++i) {
+        trades.push_back(MakeTrade(i));
+    }
+    for (auto _ : state) {
+        double total = 0;
+        for (double price : trades.column<TradeDef::price>()) {
+            total += price;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Two columns: the notional value price * quantity.
+void BM_SumNotional_Vector(benchmark::State& state) {
+    container::vector<Trade> trades;
+    for (long i = 0; i < state.range(0); ++i) {
+        trades.push_back(MakeTrade(i));
+    }
+    for (auto _ : state) {
+        double total = 0;
+        for (const Trade& trade : trades) {
+            total += trade.price * trade.quantity;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SumNotional_SoaVector(benchmark::State& state) {
+    container::soa_vector<Trade> trades;
+    for (long i = 0; i < state.range(0); ++i) {
+        trades.push_back(MakeTrade(i));
+    }
+    for (auto _ : state) {
+        auto price = trades.column<TradeDef::price>();
+        auto quantity = trades.column<TradeDef::quantity>();
+        double total = 0;
+        for (size_t i = 0; i < price.size(); ++i) {
+            total += price[i] * quantity[i];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(BM_SumPrice_Vector)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK(BM_SumPrice_SoaVector)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK(BM_SumNotional_Vector)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK(BM_SumNotional_SoaVector)->Arg(1 << 12)->Arg(1 << 22);
+
+}  // namespace cpp::common::benchmarks
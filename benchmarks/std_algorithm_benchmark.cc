@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <container/vector.hpp>
+#include <vector>
+
+/*
+ * Standard algorithms over container::vector next to std::vector. Both
+ * should reach the memmove and memcmp paths of the standard library, which
+ * it takes only for iterators it can see through to a pointer; so should
+ * the members assign() and operator==.
+ */
+namespace cpp::common::benchmarks {
+
+namespace {
+
+template <typename Vector>
+Vector MakeSequence(size_t n) {
+    Vector vec(n);
+    for (size_t i = 0; i < n; ++i) {
+        vec[i] = int(i);
+    }
+    return vec;
+}
+
+template <typename Vector>
+void BM_StdCopy(benchmark::State& state) {
+    const auto source = MakeSequence<Vector>(state.range(0));
+    Vector target(source.size());
+    for (auto _ : state) {
+        std::copy(source.begin(), source.end(), target.begin());
+        benchmark::DoNotOptimize(target.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * source.size() * sizeof(int));
+}
+
+template <typename Vector>
+void BM_RangesCopy(benchmark::State& state) {
+    const auto source = MakeSequence<Vector>(state.range(0));
+    Vector target(source.size());
+    for (auto _ : state) {
+        std::ranges::copy(source, target.begin());
+        benchmark::DoNotOptimize(target.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * source.size() * sizeof(int));
+}
+
+template <typename Vector>
+void BM_StdEqual(benchmark::State& state) {
+    const auto lhs = MakeSequence<Vector>(state.range(0));
+    const auto rhs = lhs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(int));
+}
+
+template <typename Vector>
+void BM_Assign(benchmark::State& state) {
+    const auto source = MakeSequence<Vector>(state.range(0));
+    Vector target(source.size());
+    for (auto _ : state) {
+        target.assign(source.begin(), source.end());
+        benchmark::DoNotOptimize(target.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * source.size() * sizeof(int));
+}
+
+template <typename Vector>
+void BM_EqualMember(benchmark::State& state) {
+    const auto lhs = MakeSequence<Vector>(state.range(0));
+    const auto rhs = lhs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+    }
+    state.SetBytesProcessed(state.iterations() * lhs.size() * sizeof(int));
+}
+
+}  // namespace
+
+BENCHMARK(BM_StdCopy<std::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_StdCopy<container::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_RangesCopy<std::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_RangesCopy<container::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_StdEqual<std::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_StdEqual<container::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Assign<std::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_Assign<container::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_EqualMember<std::vector<int>>)->Range(1 << 6, 1 << 18);
+BENCHMARK(BM_EqualMember<container::vector<int>>)->Range(1 << 6, 1 << 18);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <container/vector.hpp>
+#include <string>
+
+namespace cpp::common::benchmarks {
+
+namespace {
+
+/*
+ * Wraps T with a move constructor that may throw, which forces
+ * reallocation back onto the copy-per-element path. This is what every
+ * growth step paid before reserve() learned to move.
+ */
+template <typename T>
+struct CopyOnRelocate {
+    T value;
+    CopyOnRelocate(T v) : value(std::move(v)) {}
+    CopyOnRelocate(const CopyOnRelocate&) = default;
+    CopyOnRelocate(CopyOnRelocate&& rhs) noexcept(false)
+        : value(std::move(rhs.value)) {}
+};
+
+// long enough to defeat the small string optimization
+std::string MakeString() { return std::string(64, 'x'); }
+
+container::vector<int> MakeNested() { return container::vector<int>(64, 1); }
+
+template <typename T, typename Make>
+void GrowByPushBack(benchmark::State& state, Make make) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto element = make();
+    for (auto _ : state) {
+        container::vector<T> vec;
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(T(element));
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename T, typename Make>
+void ShrinkToFit(benchmark::State& state, Make make) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto element = make();
+    for (auto _ : state) {
+        state.PauseTiming();
+        container::vector<T> vec;
+        vec.reserve(4 * n);
+        for (size_t i = 0; i < n; ++i) {
+            vec.push_back(T(element));
+        }
+        state.ResumeTiming();
+        vec.shrink_to_fit();
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_GrowString_Move(benchmark::State& state) {
+    GrowByPushBack<std::string>(state, MakeString);
+}
+void BM_GrowString_Copy(benchmark::State& state) {
+    GrowByPushBack<CopyOnRelocate<std::string>>(state, MakeString);
+}
+void BM_GrowNestedVector_Move(benchmark::State& state) {
+    GrowByPushBack<container::vector<int>>(state, MakeNested);
+}
+void BM_GrowNestedVector_Copy(benchmark::State& state) {
+    GrowByPushBack<CopyOnRelocate<container::vector<int>>>(state, MakeNested);
+}
+void BM_GrowInt_Memcpy(benchmark::State& state) {
+    GrowByPushBack<int>(state, [] { return 1; });
+}
+void BM_ShrinkToFitString_Move(benchmark::State& state) {
+    ShrinkToFit<std::string>(state, MakeString);
+}
+void BM_ShrinkToFitString_Copy(benchmark::State& state) {
+    ShrinkToFit<CopyOnRelocate<std::string>>(state, MakeString);
+}
+
+}  // namespace
+
+BENCHMARK(BM_GrowString_Move)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_GrowString_Copy)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_GrowNestedVector_Move)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_GrowNestedVector_Copy)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_GrowInt_Memcpy)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_ShrinkToFitString_Move)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_ShrinkToFitString_Copy)->Range(1 << 8, 1 << 16);
+
+}  // namespace cpp::common::benchmarks
@@ -0,0 +1,135 @@
+#pragma once
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <new>
+
+namespace cpp::common::container {
+
+/*
+ * Allocators may offer reallocate(pointer, old_n, new_n) on top of the
+ * standard interface. Containers then resize blocks of trivially
+ * relocatable elements through it instead of allocate + memcpy +
+ * deallocate.
+ */
+template <typename Allocator, typename T>
+concept reallocating_allocator =
+    requires(Allocator& alloc, T* pointer, size_t n) {
+    { alloc.reallocate(pointer, n, n) } -> std::same_as<T*>;
+};
+
+namespace detail {
+
+// malloc, or aligned_alloc for alignments malloc does not guarantee. Either
+// way the memory goes back with free().
+inline void* allocate_bytes(size_t bytes, size_t alignment) {
+    void* pointer;
+    if (alignment > alignof(std::max_align_t)) {
+        // aligned_alloc wants a multiple of the alignment
+        pointer = aligned_alloc(alignment,
+                                (bytes + alignment - 1) & ~(alignment - 1));
+    } else {
+        pointer = malloc(bytes);
+    }
+    if (!pointer && bytes) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+}  // namespace detail
+
+/*
+ * The default allocator of the containers in this directory. It hands out
+ * memory straight from malloc/free, which is what vector did before it
+ * took an Allocator parameter, and switches to aligned_alloc for
+ * over-aligned T.
+ */
+template <typename T>
+struct malloc_allocator {
+    typedef T value_type;
+
+    malloc_allocator() = default;
+    template <typename U>
+    malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return (T*)detail::allocate_bytes(n * sizeof(T), alignof(T));
+    }
+    void deallocate(T* pointer, size_t) noexcept { free(pointer); }
+    /*
+     * Resizes a block obtained from allocate() with realloc, which may
+     * extend it in place. The bytes are carried over as if by memcpy, so
+     * containers only use this for trivially relocatable elements.
+     * realloc only guarantees malloc's alignment, hence the constraint.
+     */
+    T* reallocate(T* pointer, size_t, size_t new_n)
+        requires(alignof(T) <= alignof(std::max_align_t)) {
+        if (!new_n) {
+            free(pointer);
+            return nullptr;
+        }
+        auto* result = (T*)realloc(pointer, new_n * sizeof(T));
+        if (!result) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&) {
+    return false;
+}
+
+/*
+ * Aligns every block to at least Alignment bytes, e.g. 64 for buffers that
+ * are read with aligned AVX-512 loads:
+ *
+ *     vector<float, aligned_allocator<float, 64>> samples;
+ */
+template <typename T, size_t Alignment>
+struct aligned_allocator {
+    static_assert(std::has_single_bit(Alignment),
+                  "alignment must be a power of two");
+    static constexpr size_t alignment = std::max(Alignment, alignof(T));
+
+    typedef T value_type;
+    // allocator_traits cannot rebind a non-type template parameter
+    template <typename U>
+    struct rebind {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator() = default;
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return (T*)detail::allocate_bytes(n * sizeof(T), alignment);
+    }
+    void deallocate(T* pointer, size_t) noexcept { free(pointer); }
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment>&,
+                const aligned_allocator<U, Alignment>&) {
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment>&,
+                const aligned_allocator<U, Alignment>&) {
+    return false;
+}
+
+}  // namespace cpp::common::container
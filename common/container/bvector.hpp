@@ -1,20 +1,29 @@
 #pragma once
-#include <math.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include "vector.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace cpp::common::container {
 
 struct bit_reference {
-    char* mbit_type;
-    char mbit_mask;
+    uint64_t* mbit_type;
+    uint64_t mbit_mask;
     bit_reference() : mbit_type(0), mbit_mask(0) {}
-    bit_reference(char* bit_type, char bit_mask)
+    bit_reference(uint64_t* bit_type, uint64_t bit_mask)
         : mbit_type(bit_type), mbit_mask(bit_mask) {}
     bit_reference(const bit_reference&) = default;
     operator bool() const { return !!(*mbit_type & mbit_mask); }
@@ -26,51 +35,441 @@ struct bit_reference {
         }
         return *this;
     }
+    bit_reference& operator=(const bit_reference& x) {
+        return *this = bool(x);
+    }
     bool operator==(const bit_reference& x) { return bool(*this) == bool(x); }
     bool operator<(const bit_reference& __x) const {
         return !bool(*this) && bool(__x);
     }
 
-    void flip() _GLIBCXX_NOEXCEPT { *mbit_type ^= mbit_mask; }
+    void flip() noexcept { *mbit_type ^= mbit_mask; }
 };
 
-void swap(bit_reference x, bit_reference y) {
+inline void swap(bit_reference x, bit_reference y) {
     bool tmp = x;
     x = y;
     y = tmp;
 }
 
-void swap(bit_reference x, bool& y) {
+inline void swap(bit_reference x, bool& y) {
     bool tmp = x;
     x = y;
     y = tmp;
 }
 
-void swap(bool& x, bit_reference y) {
+inline void swap(bool& x, bit_reference y) {
     bool tmp = x;
     x = y;
     y = tmp;
 }
-template <>
-class vector<bool> {
+
+namespace detail {
+
+inline constexpr size_t bits_per_word = 64;
+
+inline constexpr size_t words_for(size_t bits) {
+    return (bits + bits_per_word - 1) / bits_per_word;
+}
+
+// The bits of the last word that hold elements when there are `bits` of
+// them: all of it if the elements end on a word boundary.
+inline constexpr uint64_t tail_mask(size_t bits) {
+    const size_t used = bits % bits_per_word;
+    return used ? (uint64_t(1) << used) - 1 : ~uint64_t(0);
+}
+
+/*
+ * Iterator over the bits of a vector<bool>: the word holding the bit and
+ * the bit's index in it. Const iterators dereference to bool, the others
+ * to a bit_reference.
+ */
+template <bool Const>
+class bit_iterator {
+    typedef std::conditional_t<Const, const uint64_t, uint64_t> word_type;
+
    public:
+    typedef std::random_access_iterator_tag iterator_category;
     typedef bool value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef std::conditional_t<Const, bool, bit_reference> reference;
+
+    bit_iterator() = default;
+    bit_iterator(word_type* words, size_t index)
+        : mWord(words + index / bits_per_word),
+          mOffset(index % bits_per_word) {}
+    // iterator to const_iterator
+    template <bool OtherConst>
+        requires(Const && !OtherConst)
+    bit_iterator(const bit_iterator<OtherConst>& rhs)
+        : mWord(rhs.mWord), mOffset(rhs.mOffset) {}
+
+    reference operator*() const {
+        if constexpr (Const) {
+            return (*mWord >> mOffset) & 1;
+        } else {
+            return bit_reference(mWord, uint64_t(1) << mOffset);
+        }
+    }
+    reference operator[](difference_type dist) const {
+        return *(*this + dist);
+    }
+    bit_iterator& operator++() {
+        if (++mOffset == bits_per_word) {
+            mOffset = 0;
+            ++mWord;
+        }
+        return *this;
+    }
+    bit_iterator operator++(int) {
+        bit_iterator retval = *this;
+        ++(*this);
+        return retval;
+    }
+    bit_iterator& operator--() {
+        if (mOffset-- == 0) {
+            mOffset = bits_per_word - 1;
+            --mWord;
+        }
+        return *this;
+    }
+    bit_iterator operator--(int) {
+        bit_iterator retval = *this;
+        --(*this);
+        return retval;
+    }
+    bit_iterator& operator+=(difference_type dist) {
+        // an arithmetic shift by log2(bits_per_word) rounds down, also for
+        // the negative indices of a step back
+        const difference_type index = difference_type(mOffset) + dist;
+        mWord += index >> std::countr_zero(bits_per_word);
+        mOffset = index & (bits_per_word - 1);
+        return *this;
+    }
+    bit_iterator& operator-=(difference_type dist) { return *this += -dist; }
+    friend bit_iterator operator+(bit_iterator iter, difference_type dist) {
+        return iter += dist;
+    }
+    friend bit_iterator operator+(difference_type dist, bit_iterator iter) {
+        return iter += dist;
+    }
+    friend bit_iterator operator-(bit_iterator iter, difference_type dist) {
+        return iter -= dist;
+    }
+    friend difference_type operator-(const bit_iterator& lhs,
+                                     const bit_iterator& rhs) {
+        return (lhs.mWord - rhs.mWord) * difference_type(bits_per_word) +
+               difference_type(lhs.mOffset) - difference_type(rhs.mOffset);
+    }
+    friend bool operator==(const bit_iterator& lhs, const bit_iterator& rhs) {
+        return lhs.mWord == rhs.mWord && lhs.mOffset == rhs.mOffset;
+    }
+    friend std::strong_ordering operator<=>(const bit_iterator& lhs,
+                                            const bit_iterator& rhs) {
+        if (lhs.mWord != rhs.mWord) {
+            return lhs.mWord <=> rhs.mWord;
+        }
+        return lhs.mOffset <=> rhs.mOffset;
+    }
+    friend void swap(bit_iterator& lhs, bit_iterator& rhs) noexcept {
+        std::swap(lhs.mWord, rhs.mWord);
+        std::swap(lhs.mOffset, rhs.mOffset);
+    }
+
+   private:
+    template <bool>
+    friend class bit_iterator;
+
+    word_type* mWord = nullptr;
+    size_t mOffset = 0;
+};
+
+/*
+ * The word operations behind the bitwise operators of vector<bool>, on a
+ * word or, with SSE2, on two words in a register.
+ */
+struct bit_and {
+    uint64_t operator()(uint64_t lhs, uint64_t rhs) const { return lhs & rhs; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i lhs, __m128i rhs) const {
+        return _mm_and_si128(lhs, rhs);
+    }
+#endif
+};
+
+struct bit_or {
+    uint64_t operator()(uint64_t lhs, uint64_t rhs) const { return lhs | rhs; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i lhs, __m128i rhs) const {
+        return _mm_or_si128(lhs, rhs);
+    }
+#endif
+};
+
+struct bit_xor {
+    uint64_t operator()(uint64_t lhs, uint64_t rhs) const { return lhs ^ rhs; }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i lhs, __m128i rhs) const {
+        return _mm_xor_si128(lhs, rhs);
+    }
+#endif
+};
+
+struct bit_andnot {
+    uint64_t operator()(uint64_t lhs, uint64_t rhs) const {
+        return lhs & ~rhs;
+    }
+#if defined(__SSE2__)
+    __m128i operator()(__m128i lhs, __m128i rhs) const {
+        return _mm_andnot_si128(rhs, lhs);
+    }
+#endif
+};
+
+// dst[i] = op(dst[i], src[i]) for the n words. dst may be src.
+template <typename Op>
+void combine_words(uint64_t* dst, const uint64_t* src, size_t n, Op op) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= n; i += 4) {
+        __m128i low = op(_mm_loadu_si128((const __m128i*)(dst + i)),
+                         _mm_loadu_si128((const __m128i*)(src + i)));
+        __m128i high = op(_mm_loadu_si128((const __m128i*)(dst + i + 2)),
+                          _mm_loadu_si128((const __m128i*)(src + i + 2)));
+        _mm_storeu_si128((__m128i*)(dst + i), low);
+        _mm_storeu_si128((__m128i*)(dst + i + 2), high);
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = op(dst[i], src[i]);
+    }
+}
+
+// The number of set bits in the n words. Without the popcnt instruction
+// std::popcount is a call into libgcc per word, which the bit-parallel sum
+// below beats several times over.
+inline size_t count_words(const uint64_t* words, size_t n) {
+    size_t set = 0;
+    for (size_t i = 0; i < n; ++i) {
+#if defined(__POPCNT__)
+        set += std::popcount(words[i]);
+#else
+        uint64_t word = words[i];
+        word -= word >> 1 & 0x5555555555555555;
+        word = (word & 0x3333333333333333) + (word >> 2 & 0x3333333333333333);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0f;
+        set += word * 0x0101010101010101 >> 56;
+#endif
+    }
+    return set;
+}
+
+inline void flip_words(uint64_t* words, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i ones = _mm_set1_epi32(-1);
+    for (; i + 2 <= n; i += 2) {
+        __m128i word = _mm_loadu_si128((const __m128i*)(words + i));
+        _mm_storeu_si128((__m128i*)(words + i), _mm_xor_si128(word, ones));
+    }
+#endif
+    for (; i < n; ++i) {
+        words[i] = ~words[i];
+    }
+}
+
+/*
+ * The first index from index on, below size, whose bit xor-ed with the
+ * same bit of flip is set, or size_t(-1). Searches for clear bits with flip
+ * all ones. The bits of the last word past size have to be clear.
+ */
+inline size_t find_bit(const uint64_t* words, size_t size, size_t index,
+                       uint64_t flip) {
+    if (index >= size) {
+        return size_t(-1);
+    }
+    const size_t count = words_for(size);
+    size_t i = index / bits_per_word;
+    // drops the bits before index
+    uint64_t word = (words[i] ^ flip) & (~uint64_t(0) << index % bits_per_word);
+    while (!word) {
+        if (++i == count) {
+            return size_t(-1);
+        }
+        word = words[i] ^ flip;
+    }
+    // with flip, the clear bits past size turn up as set ones
+    const size_t found = i * bits_per_word + std::countr_zero(word);
+    return found < size ? found : size_t(-1);
+}
+
+/*
+ * Range kernels over the bits [first, last) of an array of words: masks
+ * for the partial words at either end, memset and memmove for the whole
+ * words in between.
+ */
+inline void fill_bits(uint64_t* words, size_t first, size_t last, bool val) {
+    if (first >= last) {
+        return;
+    }
+    const size_t head = first / bits_per_word;
+    const size_t tail = (last - 1) / bits_per_word;
+    const uint64_t head_mask = ~uint64_t(0) << first % bits_per_word;
+    const uint64_t tail_bits = tail_mask(last);
+    auto apply = [val](uint64_t& word, uint64_t mask) {
+        word = val ? word | mask : word & ~mask;
+    };
+    if (head == tail) {
+        apply(words[head], head_mask & tail_bits);
+        return;
+    }
+    apply(words[head], head_mask);
+    memset(words + head + 1, val ? 0xFF : 0,
+           (tail - head - 1) * sizeof(uint64_t));
+    apply(words[tail], tail_bits);
+}
+
+inline void flip_bits(uint64_t* words, size_t first, size_t last) {
+    if (first >= last) {
+        return;
+    }
+    const size_t head = first / bits_per_word;
+    const size_t tail = (last - 1) / bits_per_word;
+    const uint64_t head_mask = ~uint64_t(0) << first % bits_per_word;
+    if (head == tail) {
+        words[head] ^= head_mask & tail_mask(last);
+        return;
+    }
+    words[head] ^= head_mask;
+    flip_words(words + head + 1, tail - head - 1);
+    words[tail] ^= tail_mask(last);
+}
+
+// The count bits from index pos on, count at most 64, in the low bits.
+inline uint64_t read_bits(const uint64_t* words, size_t pos, size_t count) {
+    const size_t word = pos / bits_per_word;
+    const size_t offset = pos % bits_per_word;
+    uint64_t bits = words[word] >> offset;
+    if (offset + count > bits_per_word) {
+        bits |= words[word + 1] << (bits_per_word - offset);
+    }
+    return count < bits_per_word ? bits & tail_mask(count) : bits;
+}
+
+// Stores the low count bits of bits at index pos on, count at most 64.
+inline void write_bits(uint64_t* words, size_t pos, size_t count,
+                       uint64_t bits) {
+    const size_t word = pos / bits_per_word;
+    const size_t offset = pos % bits_per_word;
+    const uint64_t mask =
+        count < bits_per_word ? tail_mask(count) : ~uint64_t(0);
+    words[word] = (words[word] & ~(mask << offset)) | (bits << offset);
+    if (offset + count > bits_per_word) {
+        const size_t shift = bits_per_word - offset;
+        words[word + 1] =
+            (words[word + 1] & ~(mask >> shift)) | (bits >> shift);
+    }
+}
+
+/*
+ * Copies the n bits from index src_pos of src to index dst_pos of dst. The
+ * ranges may overlap, as with memmove.
+ */
+inline void copy_bits(const uint64_t* src, size_t src_pos, uint64_t* dst,
+                      size_t dst_pos, size_t n) {
+    if (!n || (src == dst && src_pos == dst_pos)) {
+        return;
+    }
+    const size_t offset = dst_pos % bits_per_word;
+    // bits in the first and in the last destination word
+    const size_t head = std::min(n, bits_per_word - offset);
+    const size_t tail = n > head ? (n - head) % bits_per_word : 0;
+    const size_t middle = (n - head - tail) / bits_per_word;
+    uint64_t* const dst_middle = dst + (dst_pos + head) / bits_per_word;
+    // a copy toward higher addresses goes from the back, so that it does
+    // not overwrite bits it has yet to read
+    const auto src_word = (uintptr_t)(src + src_pos / bits_per_word);
+    const auto dst_word = (uintptr_t)(dst + dst_pos / bits_per_word);
+    const bool backward =
+        dst_word > src_word ||
+        (dst_word == src_word && offset > src_pos % bits_per_word);
+    auto copy_head = [&] {
+        write_bits(dst, dst_pos, head, read_bits(src, src_pos, head));
+    };
+    auto copy_tail = [&] {
+        if (tail) {
+            write_bits(dst, dst_pos + n - tail, tail,
+                       read_bits(src, src_pos + n - tail, tail));
+        }
+    };
+    if (!backward) {
+        copy_head();
+    } else {
+        copy_tail();
+    }
+    // each whole destination word takes bits from two source words
+    const uint64_t* src_middle = src + (src_pos + head) / bits_per_word;
+    const size_t shift = (src_pos + head) % bits_per_word;
+    auto combine = [&](size_t i) {
+        return src_middle[i] >> shift |
+               src_middle[i + 1] << (bits_per_word - shift);
+    };
+    if (shift == 0) {
+        memmove(dst_middle, src_middle, middle * sizeof(uint64_t));
+    } else if (!backward) {
+        for (size_t i = 0; i < middle; ++i) {
+            dst_middle[i] = combine(i);
+        }
+    } else {
+        for (size_t i = middle; i-- > 0;) {
+            dst_middle[i] = combine(i);
+        }
+    }
+    if (!backward) {
+        copy_tail();
+    } else {
+        copy_head();
+    }
+}
+
+}  // namespace detail
+
+/*
+ * The bits live in 64-bit words obtained from Allocator rebound to
+ * uint64_t, with the same propagation rules and growth policies as
+ * vector<T>. Bit i is bit i % 64 of word i / 64, and the bits of the last
+ * word past size() are kept clear, so that whole-vector operations and
+ * comparisons work on the words without masking every one of them.
+ */
+template <typename Allocator, typename GrowthPolicy>
+class vector<bool, Allocator, GrowthPolicy> {
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<
+        uint64_t>
+        word_allocator;
+    typedef std::allocator_traits<word_allocator> alloc_traits;
+
+   public:
+    typedef bool value_type;
+    typedef Allocator allocator_type;
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
     typedef bit_reference reference;
     typedef bool const_reference;
     typedef bit_reference* pointer;
     typedef const bool* const_pointer;
-    //   typedef _Bit_iterator				iterator;
-    //   typedef _Bit_const_iterator			const_iterator;
+    typedef detail::bit_iterator<false> iterator;
+    typedef detail::bit_iterator<true> const_iterator;
     // typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
     // typedef std::reverse_iterator<iterator> reverse_iterator;
     vector() = default;
-    explicit vector(size_t n);
-    vector(size_t n, const bool& val);
-    vector(const vector<bool>& x);
-    vector(vector<bool>&&);
-    vector(std::initializer_list<bool> il);
+    explicit vector(const Allocator& alloc) noexcept;
+    explicit vector(size_t n, const Allocator& alloc = Allocator());
+    vector(size_t n, const bool& val, const Allocator& alloc = Allocator());
+    vector(const vector& x);
+    vector(vector&&) noexcept;
+    vector(std::initializer_list<bool> il,
+           const Allocator& alloc = Allocator());
 
     ~vector();
 
@@ -78,6 +477,8 @@ class vector<bool> {
     vector& operator=(vector&& x);
     vector& operator=(std::initializer_list<bool> il);
 
+    allocator_type get_allocator() const noexcept;
+
     // capacity
     size_t size() const noexcept;
     /*
@@ -150,421 +551,675 @@ class vector<bool> {
     // iterator emplace (const_iterator position, Args&&... args);
     // template <class... Args>
     //   void emplace_back (Args&&... args);
-    class iterator
-        : public std::iterator<std::random_access_iterator_tag, bool> {
-        char* mPointer;
-        size_t mOffset;
-        char mMask;
-
-       public:
-        using it_tag = std::iterator<std::random_access_iterator_tag, bool>;
-
-        iterator(char* pointer, size_t offset)
-            : mPointer(pointer + offset / 8),
-              mOffset(offset % 8),
-              mMask(1 << mOffset) {}
-
-        iterator& operator=(const iterator& rhs) {
-            mPointer = rhs.mPointer;
-            mOffset = rhs.mOffset;
-            mMask = rhs.mMask;
-            return *this;
-        }
-        iterator& operator++() {
-            if (mOffset < 8) {
-                ++mOffset;
-                mMask <<= 1;
-            } else {
-                ++mPointer;
-                mOffset = 0;
-                mMask = 1;
-            }
-            return *this;
-        }
-        iterator operator++(int) {
-            iterator retval = *this;
-            ++(*this);
-            return retval;
-        }
-        iterator& operator--() {
-            if (mOffset > 0) {
-                --mOffset;
-                mMask >>= 1;
-            } else {
-                --mPointer;
-                mOffset = 7;
-                mMask = 0x1 << 7;
-            }
-            return *this;
-        }
-        iterator operator--(int) {
-            iterator retval = *this;
-            --(*this);
-            return retval;
-        }
-        bool operator==(const iterator& other) const {
-            return mPointer == other.mPointer && mOffset == other.mOffset &&
-                   mMask == other.mMask;
-        }
-        bool operator!=(const iterator& other) const {
-            return !(*this == other);
-        }
-        bit_reference operator*() { return bit_reference(mPointer, mMask); }
-        iterator& operator+=(typename it_tag::difference_type dist) {
-            int poschange = floor((double(mOffset) + dist) / 8);
-            mPointer = mPointer + poschange;
-            mOffset = (mOffset + dist) % 8;
-            mMask = 1 << mOffset;
-            return *this;
-        }
-        iterator operator+(typename it_tag::difference_type dist) const {
-            iterator tmp = *this;
-            return tmp += dist;
-        }
-        iterator& operator-=(typename it_tag::difference_type dist) {
-            int poschange = floor((double(mOffset) - dist) / 8);
-            mPointer = mPointer + poschange;
-            mOffset = (mOffset - dist) % 8;
-            mMask = 1 << mOffset;
-            return *this;
-        }
-        iterator operator-(typename it_tag::difference_type dist) {
-            iterator tmp = *this;
-            return tmp -= dist;
-        }
 
-        bool operator<(const iterator& rhs) const {
-            return (mPointer < rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset < rhs.mOffset);
-        }
-        bool operator>(const iterator& rhs) const {
-            return (mPointer > rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset > rhs.mOffset);
-        }
-        bool operator<=(const iterator& rhs) const {
-            return (mPointer < rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset <= rhs.mOffset);
-        }
-        bool operator>=(const iterator& rhs) const {
-            return (mPointer > rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset >= rhs.mOffset);
-        }
+    /*
+     * The words holding the bits, word_count() of them. The bits of the
+     * last word past size() are clear.
+     */
+    const uint64_t* words() const noexcept { return mvector_data.begin; }
+    // Writes through it have to leave the bits past size() clear.
+    uint64_t* words() noexcept { return mvector_data.begin; }
+    size_t word_count() const noexcept {
+        return detail::words_for(mvector_data.used);
+    }
 
-        bit_reference operator[](typename it_tag::difference_type dist) const {
-            return *(*this + dist);
-        }
+    /*
+     * Whole-vector bitwise operations. They run a word at a time, or two
+     * words at a time with SSE2, instead of a bit at a time. Both vectors
+     * must have the same size, otherwise std::invalid_argument is thrown.
+     */
+    vector& operator&=(const vector& rhs);
+    vector& operator|=(const vector& rhs);
+    vector& operator^=(const vector& rhs);
+    // Clears the bits that are set in rhs: *this &= ~rhs without the copy.
+    vector& andnot(const vector& rhs);
+    void flip() noexcept;
+    vector operator~() const;
+    /*
+     * Moves every bit n indices up (<<=) or down (>>=), as std::bitset does
+     * with index 0 as its least significant bit. Bits moved past either end
+     * are dropped and the indices left behind are cleared; the size does
+     * not change.
+     */
+    vector& operator<<=(size_t n) noexcept;
+    vector& operator>>=(size_t n) noexcept;
 
-        void swap(iterator& rhs) { std::swap(mPointer, rhs.mPointer); }
-        friend iterator operator+(typename it_tag::difference_type dist,
-                                  const iterator& iter);
-    };
-    class const_iterator
-        : public std::iterator<std::random_access_iterator_tag, const bool> {
-        char* mPointer;
-        size_t mOffset;
-        char mMask;
-
-       public:
-        using it_tag =
-            std::iterator<std::random_access_iterator_tag, const bool>;
-
-        const_iterator(char* pointer, size_t offset)
-            : mPointer(pointer + offset / 8),
-              mOffset(offset % 8),
-              mMask(1 << mOffset) {}
-
-        const_iterator& operator=(const const_iterator& rhs) {
-            mPointer = rhs.mPointer;
-            mOffset = rhs.mOffset;
-            mMask = rhs.mMask;
-            return *this;
-        }
-        const_iterator& operator++() {
-            if (mOffset < 8) {
-                ++mOffset;
-                mMask <<= 1;
-            } else {
-                ++mPointer;
-                mOffset = 0;
-                mMask = 1;
-            }
-            return *this;
-        }
-        const_iterator operator++(int) {
-            const_iterator retval = *this;
-            ++(*this);
-            return retval;
-        }
-        const_iterator& operator--() {
-            if (mOffset > 0) {
-                --mOffset;
-                mMask >>= 1;
-            } else {
-                --mPointer;
-                mOffset = 7;
-                mMask = 0x1 << 7;
-            }
-            return *this;
-        }
-        const_iterator operator--(int) {
-            const_iterator retval = *this;
-            --(*this);
-            return retval;
-        }
-        bool operator==(const const_iterator& other) const {
-            return mPointer == other.mPointer && mOffset == other.mOffset &&
-                   mMask == other.mMask;
-        }
-        bool operator!=(const const_iterator& other) const {
-            return !(*this == other);
-        }
-        bit_reference operator*() { return bit_reference(mPointer, mMask); }
-
-        const_iterator& operator+=(typename it_tag::difference_type dist) {
-            int poschange = floor((double(mOffset) + dist) / 8);
-            mPointer = mPointer + poschange;
-            mOffset = (mOffset + dist) % 8;
-            mMask = 1 << mOffset;
-            return *this;
-        }
-        const_iterator operator+(typename it_tag::difference_type dist) const {
-            const_iterator tmp = *this;
-            return tmp += dist;
-        }
-        const_iterator& operator-=(typename it_tag::difference_type dist) {
-            int poschange = floor((double(mOffset) - dist) / 8);
-            mPointer = mPointer + poschange;
-            mOffset = (mOffset - dist) % 8;
-            mMask = 1 << mOffset;
-            return *this;
-        }
-        const_iterator operator-(typename it_tag::difference_type dist) const {
-            const_iterator tmp = *this;
-            return tmp -= dist;
-        }
-        bool operator<(const const_iterator& rhs) const {
-            return (mPointer < rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset < rhs.mOffset);
-        }
-        bool operator>(const const_iterator& rhs) const {
-            return (mPointer > rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset > rhs.mOffset);
-        }
-        bool operator<=(const const_iterator& rhs) const {
-            return (mPointer < rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset <= rhs.mOffset);
-        }
-        bool operator>=(const const_iterator& rhs) const {
-            return (mPointer > rhs.mPointer) ||
-                   (mPointer == rhs.mPointer && mOffset >= rhs.mOffset);
-        }
-        bit_reference operator[](typename it_tag::difference_type dist) const {
-            return *(*this + dist);
-        }
-        void swap(const_iterator& rhs) { std::swap(mPointer, rhs.mPointer); }
-        friend const_iterator operator+(typename it_tag::difference_type dist,
-                                        const const_iterator& iter);
-    };
+    /*
+     * Range operations on the bits [first, last) and, for copy_bits(), on
+     * the n bits from index dst_pos on, which take the values of those
+     * from src_pos on in src. src may be *this, and the two ranges may
+     * overlap. A range that does not fit the size throws
+     * std::out_of_range. These work a word at a time; std::fill, std::copy
+     * and the like on the iterators still go bit by bit.
+     */
+    void set(size_t first, size_t last, bool val = true);
+    void reset(size_t first, size_t last) { set(first, last, false); }
+    void flip(size_t first, size_t last);
+    void copy_bits(const vector& src, size_t src_pos, size_t dst_pos,
+                   size_t n);
+
+    /*
+     * Counting and scanning a word at a time with std::popcount and
+     * std::countr_zero, which become the popcnt and tzcnt instructions
+     * where the target has them (see CPP_NATIVE_ARCH). The find functions
+     * return npos when there is no such bit; find_next(pos) looks at the
+     * bits after pos, so find_next(npos) is npos as well.
+     */
+    static constexpr size_t npos = size_t(-1);
+    size_t count() const noexcept;
+    bool any() const noexcept;
+    bool none() const noexcept { return !any(); }
+    bool all() const noexcept;
+    size_t find_first() const noexcept { return find_from(0, 0); }
+    size_t find_next(size_t pos) const noexcept {
+        return size() != 0 && pos < size() - 1 ? find_from(pos + 1, 0) : npos;
+    }
+    size_t find_first_unset() const noexcept {
+        return find_from(0, ~uint64_t(0));
+    }
+    size_t find_next_unset(size_t pos) const noexcept {
+        return size() != 0 && pos < size() - 1
+                   ? find_from(pos + 1, ~uint64_t(0))
+                   : npos;
+    }
 
     iterator begin() { return iterator(mvector_data.begin, 0); }
     const_iterator begin() const {
         return const_iterator(mvector_data.begin, 0);
     }
-    iterator end() {
-        return iterator(mvector_data.begin + mvector_data.used / 8,
-                        mvector_data.used % 8);
-    }
+    iterator end() { return iterator(mvector_data.begin, mvector_data.used); }
     const_iterator end() const {
-        return const_iterator(mvector_data.begin + mvector_data.used / 8,
-                              mvector_data.used % 8);
+        return const_iterator(mvector_data.begin, mvector_data.used);
     }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
 
    private:
+    // Returns the buffer to the allocator and leaves the vector empty.
+    void release() noexcept;
+    void copy_into_empty(const vector& rhs);
+    // Clears the bits of the last word past size().
+    void clear_tail() noexcept {
+        if (mvector_data.used % detail::bits_per_word) {
+            mvector_data.begin[mvector_data.used / detail::bits_per_word] &=
+                detail::tail_mask(mvector_data.used);
+        }
+    }
+    size_t find_from(size_t index, uint64_t flip) const noexcept {
+        return detail::find_bit(mvector_data.begin, mvector_data.used, index,
+                                flip);
+    }
+    void check_range(size_t first, size_t last, const char* what) const {
+        if (first > last || last > mvector_data.used) {
+            throw std::out_of_range(what);
+        }
+    }
+    void check_same_size(const vector& rhs, const char* what) const {
+        if (rhs.mvector_data.used != mvector_data.used) {
+            throw std::invalid_argument(what);
+        }
+    }
+    // Storage is handed out in whole words, the growth policy sees words.
+    size_t grown_storage(size_t required_bits) const {
+        return detail::bits_per_word *
+               GrowthPolicy::capacity(
+                   mvector_data.storage / detail::bits_per_word,
+                   detail::words_for(required_bits), sizeof(uint64_t));
+    }
+
     struct vector_data {
-        char* begin = nullptr;
+        uint64_t* begin = nullptr;
         size_t used = 0;
         size_t storage = 0;
+        [[no_unique_address]] word_allocator alloc;
         vector_data() {}
-        ~vector_data() {
-            if (begin) free(begin);
+        explicit vector_data(const word_allocator& a) : alloc(a) {}
+        ~vector_data() { destroy_memory(); }
+        uint64_t* allocate(size_t words) {
+            if (!words) {
+                return nullptr;
+            }
+            uint64_t* pointer = alloc_traits::allocate(alloc, words);
+            detail::on_allocate<vector>(words * sizeof(uint64_t));
+            return pointer;
+        }
+        void deallocate() {
+            if (begin) {
+                alloc_traits::deallocate(alloc, begin,
+                                         storage / detail::bits_per_word);
+            }
+        }
+        // Reports the buffer as retired, before it is freed or replaced.
+        void retire() const {
+            if (begin) {
+                detail::on_retire<vector>(used, (storage - used) / 8);
+            }
+        }
+        void destroy_memory() {
+            retire();
+            deallocate();
+        }
+        void steal(vector_data& rhs) noexcept {
+            begin = rhs.begin;
+            used = rhs.used;
+            storage = rhs.storage;
+            rhs.begin = nullptr;
+            rhs.used = 0;
+            rhs.storage = 0;
+        }
+        // Moves the bits into a buffer of new_storage bits.
+        void reallocate(size_t new_storage) {
+            const size_t words = storage / detail::bits_per_word;
+            const size_t new_words = new_storage / detail::bits_per_word;
+            const size_t copied =
+                std::min(words, new_words) * sizeof(uint64_t);
+            const auto old_begin = (uintptr_t)begin;
+            if constexpr (reallocating_allocator<word_allocator, uint64_t>) {
+                begin = alloc.reallocate(begin, words, new_words);
+                detail::on_allocate<vector>(new_words * sizeof(uint64_t));
+                if (old_begin) {
+                    detail::on_reallocate<vector>(
+                        (uintptr_t)begin != old_begin ? copied : 0);
+                    detail::on_retire<vector>(used, (storage - used) / 8);
+                }
+            } else {
+                uint64_t* temp = allocate(new_words);
+                if (begin) {
+                    memcpy(temp, begin, copied);
+                    detail::on_reallocate<vector>(copied);
+                }
+                retire();
+                deallocate();
+                begin = temp;
+            }
+            storage = new_storage;
         }
-        void destroy_memory() { free(begin); }
     };
     vector_data mvector_data;
 };
 
-static size_t bool_calculate_storage(size_t size) {
-    /*
-     * if on x86
-     * asm(bsr)
-     */
-    size_t storage = 8;
-    while (storage < size) {
-        storage = storage << 1;
-    }
-    return storage;
-}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(const Allocator& alloc) noexcept
+    : mvector_data(word_allocator(alloc)) {}
 
-vector<bool>::vector(size_t n) : vector(n, false) {}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(size_t n, const Allocator& alloc)
+    : vector(n, false, alloc) {}
 
-vector<bool>::vector(size_t n, const bool& val) {
-    size_t bytenum = ceil(double(n) / 8);
-    mvector_data.begin = (char*)malloc(bytenum);
-    if (val) {
-        memset(mvector_data.begin, 0xFF, bytenum);
-    } else {
-        memset(mvector_data.begin, 0, bytenum);
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(size_t n, const bool& val,
+                                              const Allocator& alloc)
+    : mvector_data(word_allocator(alloc)) {
+    const size_t words = detail::words_for(n);
+    mvector_data.begin = mvector_data.allocate(words);
+    if (words) {
+        memset(mvector_data.begin, val ? 0xFF : 0, words * sizeof(uint64_t));
     }
     mvector_data.used = n;
-    mvector_data.storage = 8 * bytenum;
+    mvector_data.storage = detail::bits_per_word * words;
+    clear_tail();
 }
 
-vector<bool>::vector(const vector<bool>& rhs) { *this = rhs; }
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(const vector& rhs)
+    : mvector_data(alloc_traits::select_on_container_copy_construction(
+          rhs.mvector_data.alloc)) {
+    copy_into_empty(rhs);
+}
 
-vector<bool>::vector(vector<bool>&& rhs) {
-    *this = std::forward<vector<bool>>(rhs);
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(vector&& rhs) noexcept
+    : mvector_data(std::move(rhs.mvector_data.alloc)) {
+    mvector_data.steal(rhs.mvector_data);
 }
 
-vector<bool>::vector(std::initializer_list<bool> il) {
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::vector(std::initializer_list<bool> il,
+                                              const Allocator& alloc)
+    : mvector_data(word_allocator(alloc)) {
     reserve(il.size());
     for (auto& ele : il) {
         push_back(ele);
     }
 }
 
-vector<bool>::~vector() {}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::~vector() {}
 
-size_t vector<bool>::size() const noexcept { return mvector_data.used; }
+template <typename Allocator, typename GrowthPolicy>
+size_t vector<bool, Allocator, GrowthPolicy>::size() const noexcept {
+    return mvector_data.used;
+}
 
-vector<bool>& vector<bool>::operator=(const vector<bool>& rhs) {
-    mvector_data.begin = (char*)malloc(rhs.mvector_data.storage / 8);
-    memcpy(mvector_data.begin, rhs.mvector_data.begin,
-           rhs.mvector_data.storage / 8);
-    mvector_data.used = rhs.mvector_data.used;
-    mvector_data.storage = rhs.mvector_data.storage;
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator=(
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    release();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+        mvector_data.alloc = rhs.mvector_data.alloc;
+    }
+    copy_into_empty(rhs);
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator=(
+    vector<bool, Allocator, GrowthPolicy>&& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    release();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+        mvector_data.alloc = std::move(rhs.mvector_data.alloc);
+        mvector_data.steal(rhs.mvector_data);
+    } else {
+        if (mvector_data.alloc == rhs.mvector_data.alloc) {
+            mvector_data.steal(rhs.mvector_data);
+        } else {
+            copy_into_empty(rhs);
+        }
+    }
     return *this;
 }
 
-vector<bool>& vector<bool>::operator=(vector<bool>&& rhs) {
-    mvector_data = rhs.mvector_data;
-    rhs.mvector_data.begin = nullptr;
-    rhs.mvector_data.used = 0;
-    rhs.mvector_data.storage = 0;
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator=(
+    std::initializer_list<bool> il) {
+    clear();
+    reserve(il.size());
+    for (auto& ele : il) {
+        push_back(ele);
+    }
     return *this;
 }
 
-// template <typename T>
-// vector<T>& vector<T>::operator=(std::initializer_list<T> il) {
-//     *this = vector<T>(il);
-//     return *this;
-// }
+template <typename Allocator, typename GrowthPolicy>
+typename vector<bool, Allocator, GrowthPolicy>::allocator_type
+vector<bool, Allocator, GrowthPolicy>::get_allocator() const noexcept {
+    return allocator_type(mvector_data.alloc);
+}
 
-void vector<bool>::resize(size_t n, bool val) {
-    reserve(n);
-    size_t bytepos;
-    char mask;
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::release() noexcept {
+    mvector_data.destroy_memory();
+    mvector_data.begin = nullptr;
+    mvector_data.used = 0;
+    mvector_data.storage = 0;
+}
 
-    for (size_t index = mvector_data.used; index < n; ++index) {
-        bytepos = index / 8;
-        mask = 1 << (index % 8);
-        mvector_data.begin[bytepos] &= ~mask;
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::copy_into_empty(
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    mvector_data.begin = mvector_data.allocate(rhs.mvector_data.storage /
+                                               detail::bits_per_word);
+    if (rhs.mvector_data.used) {
+        memcpy(mvector_data.begin, rhs.mvector_data.begin,
+               rhs.word_count() * sizeof(uint64_t));
     }
+    mvector_data.used = rhs.mvector_data.used;
+    mvector_data.storage = rhs.mvector_data.storage;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::resize(size_t n, bool val) {
+    reserve(n);
+    detail::fill_bits(mvector_data.begin, mvector_data.used, n, val);
     mvector_data.used = n;
+    clear_tail();
 }
 
-size_t vector<bool>::capacity() const noexcept { return mvector_data.storage; }
+template <typename Allocator, typename GrowthPolicy>
+size_t vector<bool, Allocator, GrowthPolicy>::capacity() const noexcept {
+    return mvector_data.storage;
+}
 
-bool vector<bool>::empty() const noexcept { return mvector_data.used == 0; }
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::empty() const noexcept {
+    return mvector_data.used == 0;
+}
 
-void vector<bool>::reserve(size_t n) {
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::reserve(size_t n) {
     if (mvector_data.storage < n) {
-        size_t new_storage = bool_calculate_storage(n);
-        char* temp = (char*)malloc(new_storage / 8);
-        memcpy(temp, mvector_data.begin, mvector_data.storage / 8);
-
-        mvector_data.destroy_memory();
-        mvector_data.begin = temp;
-        mvector_data.storage = new_storage;
+        mvector_data.reallocate(grown_storage(n));
     }
 }
 
-void vector<bool>::shrink_to_fit() {
-    size_t new_storage = bool_calculate_storage(mvector_data.used);
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::shrink_to_fit() {
+    size_t new_storage =
+        detail::bits_per_word *
+        GrowthPolicy::capacity(0, word_count(), sizeof(uint64_t));
     if (new_storage < mvector_data.storage) {
-        char* temp = (char*)malloc(new_storage / 8);
-        memcpy(temp, mvector_data.begin, mvector_data.storage / 8);
-
-        mvector_data.destroy_memory();
-        mvector_data.begin = temp;
-        mvector_data.storage = new_storage;
+        mvector_data.reallocate(new_storage);
     }
 }
 
-bit_reference vector<bool>::operator[](size_t n) {
+template <typename Allocator, typename GrowthPolicy>
+bit_reference vector<bool, Allocator, GrowthPolicy>::operator[](size_t n) {
     return *iterator(mvector_data.begin, n);
 }
 
-bool vector<bool>::operator[](size_t n) const {
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::operator[](size_t n) const {
     return *const_iterator(mvector_data.begin, n);
 }
 
-bit_reference vector<bool>::at(size_t n) {
+template <typename Allocator, typename GrowthPolicy>
+bit_reference vector<bool, Allocator, GrowthPolicy>::at(size_t n) {
     if (n < 0 || n >= mvector_data.used) {
         throw std::out_of_range(".at(): Invalid index!");
     }
     return (*this)[n];
 }
 
-bool vector<bool>::at(size_t n) const {
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::at(size_t n) const {
     if (n < 0 || n >= mvector_data.used) {
         throw std::out_of_range(".at(): Invalid index!");
     }
     return (*this)[n];
 }
 
-bit_reference vector<bool>::front() { return *begin(); }
+template <typename Allocator, typename GrowthPolicy>
+bit_reference vector<bool, Allocator, GrowthPolicy>::front() {
+    return *begin();
+}
 
-bool vector<bool>::front() const { return *begin(); }
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::front() const {
+    return *begin();
+}
 
-bit_reference vector<bool>::back() { return *(end() - 1); }
+template <typename Allocator, typename GrowthPolicy>
+bit_reference vector<bool, Allocator, GrowthPolicy>::back() {
+    return *(end() - 1);
+}
 
-bool vector<bool>::back() const { return *(end() - 1); }
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::back() const {
+    return *(end() - 1);
+}
 
-void vector<bool>::assign(size_t n, const bool& val) { *this = vector(n, val); }
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::assign(size_t n, const bool& val) {
+    clear();
+    resize(n, val);
+}
 
-void vector<bool>::push_back(bool val) {
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::push_back(bool val) {
     if (mvector_data.used == mvector_data.storage) {
         reserve(mvector_data.used + 1);
     }
-    size_t bytepos = mvector_data.used / 8;
-    char mask = 1 << mvector_data.used % 8;
-    if (val) {
-        mvector_data.begin[bytepos] |= mask;
+    const size_t used = mvector_data.used;
+    uint64_t& word = mvector_data.begin[used / detail::bits_per_word];
+    if (used % detail::bits_per_word == 0) {
+        // the first bit of a word that holds no elements yet
+        word = val;
     } else {
-        mvector_data.begin[bytepos] &= ~(mask);
+        word |= uint64_t(val) << used % detail::bits_per_word;
     }
     mvector_data.used++;
 }
 
-void vector<bool>::pop_back() { mvector_data.used--; }
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::pop_back() {
+    mvector_data.used--;
+    (*this)[mvector_data.used] = false;
+}
 
-void vector<bool>::swap(vector<bool>& x) {
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::swap(
+    vector<bool, Allocator, GrowthPolicy>& x) {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(mvector_data.alloc, x.mvector_data.alloc);
+    }
     std::swap(mvector_data.begin, x.mvector_data.begin);
     std::swap(mvector_data.used, x.mvector_data.used);
     std::swap(mvector_data.storage, x.mvector_data.storage);
 }
 
-void vector<bool>::clear() noexcept { mvector_data.used = 0; }
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::clear() noexcept {
+    mvector_data.used = 0;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator&=(const vector& rhs) {
+    check_same_size(rhs, "operator&=: Size mismatch!");
+    detail::combine_words(mvector_data.begin, rhs.mvector_data.begin,
+                          word_count(), detail::bit_and());
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator|=(const vector& rhs) {
+    check_same_size(rhs, "operator|=: Size mismatch!");
+    detail::combine_words(mvector_data.begin, rhs.mvector_data.begin,
+                          word_count(), detail::bit_or());
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator^=(const vector& rhs) {
+    check_same_size(rhs, "operator^=: Size mismatch!");
+    detail::combine_words(mvector_data.begin, rhs.mvector_data.begin,
+                          word_count(), detail::bit_xor());
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::andnot(const vector& rhs) {
+    check_same_size(rhs, ".andnot(): Size mismatch!");
+    detail::combine_words(mvector_data.begin, rhs.mvector_data.begin,
+                          word_count(), detail::bit_andnot());
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::flip() noexcept {
+    detail::flip_words(mvector_data.begin, word_count());
+    clear_tail();
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>::operator~() const {
+    vector result(*this);
+    result.flip();
+    return result;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator<<=(size_t n) noexcept {
+    uint64_t* words = mvector_data.begin;
+    const size_t count = word_count();
+    if (n >= mvector_data.used) {
+        if (count) {
+            memset(words, 0, count * sizeof(uint64_t));
+        }
+        return *this;
+    }
+    const size_t word_shift = n / detail::bits_per_word;
+    const size_t bit_shift = n % detail::bits_per_word;
+    if (bit_shift == 0) {
+        memmove(words + word_shift, words,
+                (count - word_shift) * sizeof(uint64_t));
+    } else {
+        for (size_t i = count - 1; i > word_shift; --i) {
+            words[i] = words[i - word_shift] << bit_shift |
+                       words[i - word_shift - 1] >>
+                           (detail::bits_per_word - bit_shift);
+        }
+        words[word_shift] = words[0] << bit_shift;
+    }
+    memset(words, 0, word_shift * sizeof(uint64_t));
+    clear_tail();
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy>&
+vector<bool, Allocator, GrowthPolicy>::operator>>=(size_t n) noexcept {
+    uint64_t* words = mvector_data.begin;
+    const size_t count = word_count();
+    if (n >= mvector_data.used) {
+        if (count) {
+            memset(words, 0, count * sizeof(uint64_t));
+        }
+        return *this;
+    }
+    const size_t word_shift = n / detail::bits_per_word;
+    const size_t bit_shift = n % detail::bits_per_word;
+    // the words that keep some of the bits
+    const size_t kept = count - word_shift;
+    if (bit_shift == 0) {
+        memmove(words, words + word_shift, kept * sizeof(uint64_t));
+    } else {
+        for (size_t i = 0; i + 1 < kept; ++i) {
+            words[i] = words[i + word_shift] >> bit_shift |
+                       words[i + word_shift + 1]
+                           << (detail::bits_per_word - bit_shift);
+        }
+        words[kept - 1] = words[count - 1] >> bit_shift;
+    }
+    memset(words + kept, 0, word_shift * sizeof(uint64_t));
+    return *this;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::set(size_t first, size_t last,
+                                                bool val) {
+    check_range(first, last, ".set(): Invalid range!");
+    detail::fill_bits(mvector_data.begin, first, last, val);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::flip(size_t first, size_t last) {
+    check_range(first, last, ".flip(): Invalid range!");
+    detail::flip_bits(mvector_data.begin, first, last);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void vector<bool, Allocator, GrowthPolicy>::copy_bits(const vector& src,
+                                                      size_t src_pos,
+                                                      size_t dst_pos,
+                                                      size_t n) {
+    src.check_range(src_pos, src_pos + n, ".copy_bits(): Invalid range!");
+    check_range(dst_pos, dst_pos + n, ".copy_bits(): Invalid range!");
+    detail::copy_bits(src.mvector_data.begin, src_pos, mvector_data.begin,
+                      dst_pos, n);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+size_t vector<bool, Allocator, GrowthPolicy>::count() const noexcept {
+    return detail::count_words(mvector_data.begin, word_count());
+}
+
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::any() const noexcept {
+    for (size_t i = 0; i < word_count(); ++i) {
+        if (mvector_data.begin[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+bool vector<bool, Allocator, GrowthPolicy>::all() const noexcept {
+    const size_t words = word_count();
+    for (size_t i = 0; i + 1 < words; ++i) {
+        if (~mvector_data.begin[i]) {
+            return false;
+        }
+    }
+    return !words || mvector_data.begin[words - 1] ==
+                         detail::tail_mask(mvector_data.used);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator&(
+    vector<bool, Allocator, GrowthPolicy> lhs,
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator|(
+    vector<bool, Allocator, GrowthPolicy> lhs,
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator^(
+    vector<bool, Allocator, GrowthPolicy> lhs,
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    lhs ^= rhs;
+    return lhs;
+}
 
-vector<bool>::iterator operator+(vector<bool>::iterator::difference_type dist,
-                                 const vector<bool>::iterator& iter) {
-    return iter + dist;
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator<<(
+    vector<bool, Allocator, GrowthPolicy> lhs, size_t n) {
+    lhs <<= n;
+    return lhs;
 }
 
-vector<bool>::const_iterator operator+(
-    vector<bool>::const_iterator::difference_type dist,
-    const vector<bool>::const_iterator& iter) {
-    return iter + dist;
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator>>(
+    vector<bool, Allocator, GrowthPolicy> lhs, size_t n) {
+    lhs >>= n;
+    return lhs;
+}
+
+// More specialized than the operators of vector<T>, which compare the
+// element storage directly. Both compare whole words, which works because
+// the bits past size() are clear.
+template <typename Allocator, typename GrowthPolicy>
+bool operator==(const vector<bool, Allocator, GrowthPolicy>& lhs,
+                const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    return lhs.size() == rhs.size() &&
+           detail::equal(lhs.words(), rhs.words(), lhs.word_count());
+}
+
+template <typename Allocator, typename GrowthPolicy>
+std::strong_ordering operator<=>(
+    const vector<bool, Allocator, GrowthPolicy>& lhs,
+    const vector<bool, Allocator, GrowthPolicy>& rhs) {
+    const size_t n = std::min(lhs.size(), rhs.size());
+    const size_t words = detail::words_for(n);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t differ = lhs.words()[i] ^ rhs.words()[i];
+        if (i == words - 1) {
+            differ &= detail::tail_mask(n);
+        }
+        if (differ) {
+            // the lowest differing bit has the lowest index
+            const int bit = std::countr_zero(differ);
+            return bool(lhs.words()[i] >> bit & 1) <=>
+                   bool(rhs.words()[i] >> bit & 1);
+        }
+    }
+    return lhs.size() <=> rhs.size();
 }
 
-}  // namespace cpp::common::container
\ No newline at end of file
+}  // namespace cpp::common::container
@@ -0,0 +1,31 @@
+#pragma once
+#include <stddef.h>
+
+#include <utility>
+
+namespace cpp::common::container {
+
+// The cache line size of current x86-64 and most ARM cores.
+inline constexpr size_t cache_line_size = 64;
+
+/*
+ * Aligns and pads T to a whole number of cache lines, so that neighbouring
+ * elements of a vector<cache_padded<T>>, e.g. per-thread counters, are
+ * never in the same line and writes to one do not invalidate the other
+ * (false sharing).
+ */
+template <typename T>
+struct alignas(cache_line_size) cache_padded {
+    T value;
+
+    cache_padded() = default;
+    cache_padded(const T& v) : value(v) {}
+    cache_padded(T&& v) : value(std::move(v)) {}
+
+    T& operator*() noexcept { return value; }
+    const T& operator*() const noexcept { return value; }
+    T* operator->() noexcept { return &value; }
+    const T* operator->() const noexcept { return &value; }
+};
+
+}  // namespace cpp::common::container
@@ -0,0 +1,253 @@
+#pragma once
+#include <stddef.h>
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
+#include "index_iterator.hpp"
+
+namespace cpp::common::container {
+
+/*
+ * An append-only vector that many threads may push to and read from at
+ * once without a lock. Elements live in buckets of 8, 16, 32, ... elements
+ * that are allocated on demand and never move, so references and indices
+ * stay valid while other threads append.
+ *
+ * push_back() and emplace_back() claim an index with a single fetch_add
+ * and construct the element in place; apart from the allocation of a new
+ * bucket, which racing threads settle with one compare-exchange, they
+ * finish in a bounded number of steps. They return the claimed index. An
+ * element whose construction may throw is built before an index is
+ * claimed and then moved in, so a throw leaves no gap.
+ *
+ * size() counts the leading elements that are fully constructed; every
+ * append moves it past the elements finished so far. Those elements, and
+ * with them operator[], iteration and at(), are safe to read while other
+ * threads append. An element beyond size() may be read once is_ready()
+ * returned true for its index, or once its push_back() returned in a
+ * thread that happens-before the read. Should the allocation of a bucket
+ * fail, the index that needed it never becomes ready and size() stays
+ * below it.
+ *
+ * Destruction, like any other use of a vector that is being destroyed,
+ * must not race with appends. The allocator must be thread safe.
+ */
+template <typename T, typename Allocator = malloc_allocator<T>>
+class concurrent_vector {
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "fancy pointers are not supported");
+    static constexpr size_t first_bucket_bits = 3;
+    static constexpr size_t bucket_count = 64 - first_bucket_bits;
+
+   public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef detail::index_iterator<concurrent_vector, T> iterator;
+    typedef detail::index_iterator<const concurrent_vector, const T>
+        const_iterator;
+
+    concurrent_vector() = default;
+    explicit concurrent_vector(const Allocator& alloc) : mAlloc(alloc) {}
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+    ~concurrent_vector();
+
+    allocator_type get_allocator() const noexcept { return mAlloc; }
+
+    size_t push_back(const T& val) { return emplace_back(val); }
+    size_t push_back(T&& val) { return emplace_back(std::move(val)); }
+    template <class... Args>
+    size_t emplace_back(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            return append(std::forward<Args>(args)...);
+        } else {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                          "elements must be nothrow constructible from the "
+                          "arguments or nothrow move constructible");
+            T val(std::forward<Args>(args)...);
+            return append(std::move(val));
+        }
+    }
+    // Allocates the buckets for the first n elements up front.
+    void reserve(size_t n);
+
+    size_t size() const noexcept {
+        return mReady.load(std::memory_order_acquire);
+    }
+    bool empty() const noexcept { return size() == 0; }
+    // Whether the element at index n is fully constructed.
+    bool is_ready(size_t n) const noexcept;
+
+    // The element at index n, which must be below size() or ready.
+    T& operator[](size_t n) {
+        auto [bucket, offset] = locate(n);
+        return mBuckets[bucket].load(std::memory_order_acquire)[offset];
+    }
+    const T& operator[](size_t n) const {
+        return const_cast<concurrent_vector*>(this)->operator[](n);
+    }
+    /*
+     * Throws out_of_range unless the element at index n is ready, which
+     * makes it safe to use without any other synchronization.
+     */
+    T& at(size_t n);
+    const T& at(size_t n) const;
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+   private:
+    struct location {
+        size_t bucket;
+        size_t offset;
+    };
+    // Index n is element n + 8 of the sequence of buckets that started
+    // with buckets of size 1, 2 and 4.
+    static location locate(size_t n) {
+        size_t shifted = n + (size_t(1) << first_bucket_bits);
+        size_t bucket = std::bit_width(shifted) - 1 - first_bucket_bits;
+        return {bucket, shifted - bucket_size(bucket)};
+    }
+    static size_t bucket_size(size_t bucket) {
+        return size_t(1) << (bucket + first_bucket_bits);
+    }
+    /*
+     * A bucket is a single allocation of T that holds bucket_size() slots
+     * followed by one ready flag per slot.
+     */
+    static size_t allocation_size(size_t bucket) {
+        size_t n = bucket_size(bucket);
+        size_t flag_bytes = n * sizeof(std::atomic<bool>);
+        return n + (flag_bytes + sizeof(T) - 1) / sizeof(T);
+    }
+    static std::atomic<bool>* ready_flags(T* values, size_t bucket) {
+        return (std::atomic<bool>*)(values + bucket_size(bucket));
+    }
+    T* get_bucket(size_t bucket) {
+        T* values = mBuckets[bucket].load(std::memory_order_acquire);
+        return values ? values : allocate_bucket(bucket);
+    }
+    T* allocate_bucket(size_t bucket);
+    // Claims an index and constructs the element there, which must not
+    // throw.
+    template <class... Args>
+    size_t append(Args&&... args);
+    // Moves mReady past the ready elements at its position.
+    void publish() noexcept;
+
+    std::atomic<T*> mBuckets[bucket_count] = {};
+    // Claimed indices.
+    std::atomic<size_t> mSize = 0;
+    // Indices below which every element is ready.
+    std::atomic<size_t> mReady = 0;
+    [[no_unique_address]] Allocator mAlloc;
+};
+
+template <typename T, typename Allocator>
+concurrent_vector<T, Allocator>::~concurrent_vector() {
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        T* values = mBuckets[bucket].load(std::memory_order_acquire);
+        if (!values) {
+            continue;
+        }
+        std::atomic<bool>* ready = ready_flags(values, bucket);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < bucket_size(bucket); ++i) {
+                if (ready[i].load(std::memory_order_relaxed)) {
+                    values[i].~T();
+                }
+            }
+        }
+        alloc_traits::deallocate(mAlloc, values, allocation_size(bucket));
+    }
+}
+
+template <typename T, typename Allocator>
+T* concurrent_vector<T, Allocator>::allocate_bucket(size_t bucket) {
+    T* values = alloc_traits::allocate(mAlloc, allocation_size(bucket));
+    std::atomic<bool>* ready = ready_flags(values, bucket);
+    for (size_t i = 0; i < bucket_size(bucket); ++i) {
+        new (ready + i) std::atomic<bool>(false);
+    }
+    T* expected = nullptr;
+    if (!mBuckets[bucket].compare_exchange_strong(expected, values,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+        // another thread installed the bucket first
+        alloc_traits::deallocate(mAlloc, values, allocation_size(bucket));
+        return expected;
+    }
+    return values;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+size_t concurrent_vector<T, Allocator>::append(Args&&... args) {
+    const size_t index = mSize.fetch_add(1, std::memory_order_acq_rel);
+    auto [bucket, offset] = locate(index);
+    T* values = get_bucket(bucket);
+    new (values + offset) T(std::forward<Args>(args)...);
+    // seq_cst, like the loads in publish(): of two threads that finish
+    // neighbouring elements, at least one sees the other's flag set
+    ready_flags(values, bucket)[offset].store(true, std::memory_order_seq_cst);
+    publish();
+    return index;
+}
+
+template <typename T, typename Allocator>
+void concurrent_vector<T, Allocator>::publish() noexcept {
+    size_t ready = mReady.load(std::memory_order_seq_cst);
+    while (is_ready(ready)) {
+        // on failure another thread moved it, and ready is its new value
+        if (mReady.compare_exchange_weak(ready, ready + 1,
+                                         std::memory_order_seq_cst)) {
+            ++ready;
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void concurrent_vector<T, Allocator>::reserve(size_t n) {
+    if (n == 0) {
+        return;
+    }
+    for (size_t bucket = 0; bucket <= locate(n - 1).bucket; ++bucket) {
+        get_bucket(bucket);
+    }
+}
+
+template <typename T, typename Allocator>
+bool concurrent_vector<T, Allocator>::is_ready(size_t n) const noexcept {
+    auto [bucket, offset] = locate(n);
+    T* values = mBuckets[bucket].load(std::memory_order_acquire);
+    return values &&
+           ready_flags(values, bucket)[offset].load(std::memory_order_seq_cst);
+}
+
+template <typename T, typename Allocator>
+T& concurrent_vector<T, Allocator>::at(size_t n) {
+    if (n >= size() &&
+        (n >= mSize.load(std::memory_order_acquire) || !is_ready(n))) {
+        throw std::out_of_range(".at(): Invalid index!");
+    }
+    return (*this)[n];
+}
+
+template <typename T, typename Allocator>
+const T& concurrent_vector<T, Allocator>::at(size_t n) const {
+    return const_cast<concurrent_vector*>(this)->at(n);
+}
+
+}  // namespace cpp::common::container
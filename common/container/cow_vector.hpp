@@ -0,0 +1,242 @@
+#pragma once
+#include <stddef.h>
+
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+
+#include "allocator.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+template <typename T, typename Allocator>
+class atomic_cow_vector;
+
+namespace detail {
+
+/*
+ * A reference-counted heap vector, the shared buffer of cow_vector. It
+ * keeps its own count rather than using a shared_ptr so that unique() can
+ * load it with acquire ordering: shared_ptr::use_count() is relaxed and
+ * does not order the reads of a copy that another thread has just
+ * released before the caller's writes.
+ */
+template <typename Vector>
+class cow_buffer {
+   public:
+    cow_buffer() = default;
+    cow_buffer(const cow_buffer& other) noexcept : mNode(other.mNode) {
+        if (mNode) {
+            mNode->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    cow_buffer(cow_buffer&& other) noexcept : mNode(other.mNode) {
+        other.mNode = nullptr;
+    }
+    cow_buffer& operator=(cow_buffer other) noexcept {
+        swap(other);
+        return *this;
+    }
+    ~cow_buffer() { reset(); }
+
+    template <class... Args>
+    static cow_buffer make(Args&&... args) {
+        cow_buffer buffer;
+        buffer.mNode = new node(std::forward<Args>(args)...);
+        return buffer;
+    }
+
+    Vector& operator*() const noexcept { return mNode->elements; }
+    explicit operator bool() const noexcept { return mNode != nullptr; }
+    // Whether this is the only reference; requires a non-empty buffer.
+    bool unique() const noexcept {
+        return mNode->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    void reset() noexcept {
+        // acq_rel: the last owner must see every other owner's accesses
+        if (mNode && mNode->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete mNode;
+        }
+        mNode = nullptr;
+    }
+    void swap(cow_buffer& other) noexcept { std::swap(mNode, other.mNode); }
+
+    friend bool operator==(const cow_buffer& lhs, const cow_buffer& rhs) {
+        return lhs.mNode == rhs.mNode;
+    }
+
+   private:
+    struct node {
+        template <class... Args>
+        explicit node(Args&&... args) : elements(std::forward<Args>(args)...) {}
+
+        Vector elements;
+        std::atomic<size_t> refs = 1;
+    };
+
+    node* mNode = nullptr;
+};
+
+}  // namespace detail
+
+/*
+ * A vector with value semantics whose copies share one reference-counted
+ * buffer. Copying costs an atomic increment regardless of size; the first
+ * mutation through a copy that is not the only owner clones the elements,
+ * so every copy behaves as an immutable snapshot of the moment it was
+ * taken.
+ *
+ * The read interface is that of a const vector. Mutation goes through
+ * edit(), which detaches and returns the underlying vector, or through the
+ * few shortcuts below that call it. References and iterators obtained
+ * from edit() must not be used after this cow_vector has been copied.
+ *
+ * Like a shared_ptr, one cow_vector object must not be modified while
+ * other threads use it; distinct copies may be used freely from different
+ * threads. atomic_cow_vector publishes versions to concurrent readers.
+ */
+template <typename T, typename Allocator = malloc_allocator<T>>
+class cow_vector {
+   public:
+    typedef vector<T, Allocator> vector_type;
+    typedef detail::cow_buffer<vector_type> buffer_type;
+    typedef T value_type;
+    typedef typename vector_type::const_iterator iterator;
+    typedef typename vector_type::const_iterator const_iterator;
+
+    cow_vector() = default;
+    explicit cow_vector(vector_type elements)
+        : mData(buffer_type::make(std::move(elements))) {}
+    cow_vector(std::initializer_list<T> il) : cow_vector(vector_type(il)) {}
+
+    // The elements as a vector, valid until this cow_vector is modified.
+    const vector_type& get() const noexcept {
+        return mData ? *mData : empty_vector();
+    }
+    // Whether no other copy shares the buffer, i.e. whether edit() is free.
+    bool unique() const noexcept { return !mData || mData.unique(); }
+
+    size_t size() const noexcept { return get().size(); }
+    bool empty() const noexcept { return get().empty(); }
+    const T& operator[](size_t n) const { return get()[n]; }
+    const T& at(size_t n) const { return get().at(n); }
+    const T& front() const { return get().front(); }
+    const T& back() const { return get().back(); }
+    const T* data() const noexcept { return get().data(); }
+    const_iterator begin() const { return get().begin(); }
+    const_iterator end() const { return get().end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /*
+     * Gives write access to the elements, first cloning them if other
+     * copies share them.
+     */
+    vector_type& edit();
+
+    void push_back(const T& val) { edit().push_back(val); }
+    void push_back(T&& val) { edit().push_back(std::move(val)); }
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        return edit().emplace_back(std::forward<Args>(args)...);
+    }
+    void pop_back() { edit().pop_back(); }
+    void resize(size_t n) { edit().resize(n); }
+    // Drops this copy's reference instead of destroying shared elements.
+    void clear() noexcept { mData.reset(); }
+
+    friend bool operator==(const cow_vector& lhs, const cow_vector& rhs) {
+        return lhs.mData == rhs.mData || lhs.get() == rhs.get();
+    }
+
+   private:
+    friend class atomic_cow_vector<T, Allocator>;
+
+    explicit cow_vector(buffer_type data)
+        : mData(std::move(data)) {}
+    static const vector_type& empty_vector() noexcept {
+        static const vector_type empty;
+        return empty;
+    }
+
+    buffer_type mData;
+};
+
+/*
+ * Publishes the current version of a table to any number of reader
+ * threads. load() takes a snapshot, which costs a reference count
+ * increment, and stays valid and unchanged however the table is updated
+ * afterwards. Writers replace the table with store() or derive the next
+ * version with update().
+ *
+ * The pointer swap is guarded by a mutex that is held for a few
+ * instructions, never while elements are copied. libstdc++'s
+ * std::atomic<std::shared_ptr> spins on a lock bit to the same effect,
+ * but releases it with relaxed ordering on load.
+ */
+template <typename T, typename Allocator = malloc_allocator<T>>
+class atomic_cow_vector {
+   public:
+    typedef cow_vector<T, Allocator> value_type;
+
+    atomic_cow_vector() = default;
+    explicit atomic_cow_vector(value_type initial)
+        : mData(std::move(initial.mData)) {}
+    atomic_cow_vector(const atomic_cow_vector&) = delete;
+    atomic_cow_vector& operator=(const atomic_cow_vector&) = delete;
+
+    value_type load() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return value_type(mData);
+    }
+    void store(value_type version) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // the old version is released by `version`, outside the lock
+        mData.swap(version.mData);
+    }
+    /*
+     * Applies edit(vector&) to a private copy of the current version and
+     * publishes the result. If another writer published in between, the
+     * copy is discarded and edit runs again on the newer version.
+     */
+    template <typename Edit>
+    void update(Edit&& edit);
+
+   private:
+    mutable std::mutex mMutex;
+    typename value_type::buffer_type mData;
+};
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::vector_type&
+cow_vector<T, Allocator>::edit() {
+    if (!mData) {
+        mData = buffer_type::make();
+    } else if (!mData.unique()) {
+        mData = buffer_type::make(*mData);
+    }
+    return *mData;
+}
+
+template <typename T, typename Allocator>
+template <typename Edit>
+void atomic_cow_vector<T, Allocator>::update(Edit&& edit) {
+    typedef typename value_type::buffer_type buffer_type;
+    buffer_type current = load().mData;
+    for (;;) {
+        auto next = current ? buffer_type::make(*current) : buffer_type::make();
+        edit(*next);
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mData == current) {
+            // the replaced version is released by `next`, outside the lock
+            mData.swap(next);
+            return;
+        }
+        current = mData;
+    }
+}
+
+}  // namespace cpp::common::container
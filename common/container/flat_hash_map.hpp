@@ -0,0 +1,618 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
+#include "vector.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace cpp::common::container {
+
+namespace detail {
+
+/*
+ * Every slot of a flat_hash_map has a control byte: the low seven bits of
+ * its key's hash when it is full, one of the negative markers below when
+ * it is not.
+ */
+inline constexpr int8_t ctrl_empty = -128;
+inline constexpr int8_t ctrl_deleted = -2;
+// Slots per group, all of whose control bytes are compared at once.
+inline constexpr size_t group_width = 16;
+
+/*
+ * The control bytes of one group. The match functions return a mask with
+ * bit i set for every matching slot i of the group.
+ */
+class ctrl_group {
+   public:
+    explicit ctrl_group(const int8_t* ctrl) {
+#if defined(__SSE2__)
+        mBytes = _mm_loadu_si128((const __m128i*)ctrl);
+#else
+        memcpy(mBytes, ctrl, group_width);
+#endif
+    }
+
+    uint32_t match(int8_t h2) const {
+#if defined(__SSE2__)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(mBytes, _mm_set1_epi8(h2)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < group_width; ++i) {
+            mask |= uint32_t(mBytes[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+    uint32_t match_empty() const { return match(ctrl_empty); }
+    // Empty and deleted slots, the only ones with the sign bit set.
+    uint32_t match_free() const {
+#if defined(__SSE2__)
+        return _mm_movemask_epi8(mBytes);
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < group_width; ++i) {
+            mask |= uint32_t(mBytes[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+   private:
+#if defined(__SSE2__)
+    __m128i mBytes;
+#else
+    int8_t mBytes[group_width];
+#endif
+};
+
+/*
+ * Spreads the entropy of weak hashes such as std::hash<int>, which is the
+ * identity, over all bits: the probe position comes from the high bits and
+ * the control byte from the low ones. The finalizer of MurmurHash3.
+ */
+inline uint64_t mix_hash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Storage for one element, constructed and destroyed by the table.
+template <typename T>
+union hash_slot {
+    hash_slot() {}
+    ~hash_slot() {}
+    T value;
+};
+
+template <typename Hash, typename KeyEqual>
+concept transparent_hash = requires {
+    typename Hash::is_transparent;
+    typename KeyEqual::is_transparent;
+};
+
+}  // namespace detail
+
+/*
+ * An open-addressing hash map in the style of Abseil's Swiss tables. The
+ * slots live in one vector and a parallel vector holds a control byte per
+ * slot. A lookup hashes the key once, then visits groups of 16 slots along
+ * a triangular probe sequence and compares the group's control bytes with
+ * seven bits of the hash in a single SSE2 instruction; only slots whose
+ * byte matches have their keys compared, and the first group with an empty
+ * slot ends a miss. The elements fill at most 7/8 of the slots.
+ *
+ * Hash and KeyEqual that both define is_transparent enable lookups by any
+ * type they accept, e.g. std::string_view for std::string keys. After
+ * reserve(n) the table does not grow while it holds at most n elements.
+ * Erasing frees the slot outright if its group has an empty slot and
+ * leaves a tombstone otherwise; should tombstones use up the free room,
+ * the next insertion rehashes at the same capacity to clear them. Live
+ * elements and tombstones together may fill 15/16 of the slots, so that
+ * each such rehash reclaims at least 1/16 of them.
+ *
+ * Inserting may rehash, which invalidates all iterators and references;
+ * erasing invalidates only those to the erased element. The elements are
+ * visited in no particular order.
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = malloc_allocator<std::pair<const Key, T>>>
+class flat_hash_map {
+    typedef detail::hash_slot<std::pair<const Key, T>> slot_type;
+    typedef typename std::allocator_traits<
+        Allocator>::template rebind_alloc<slot_type>
+        slot_allocator;
+    typedef typename std::allocator_traits<
+        Allocator>::template rebind_alloc<int8_t>
+        ctrl_allocator;
+    static constexpr bool transparent =
+        detail::transparent_hash<Hash, KeyEqual>;
+
+   public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+    typedef Allocator allocator_type;
+
+    template <bool Const>
+    class basic_iterator;
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    flat_hash_map() = default;
+    explicit flat_hash_map(size_t n, const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(),
+                           const Allocator& alloc = Allocator())
+        : mCtrl(ctrl_allocator(alloc)),
+          mSlots(slot_allocator(alloc)),
+          mHash(hash),
+          mEqual(equal) {
+        reserve(n);
+    }
+    flat_hash_map(std::initializer_list<value_type> il)
+        : flat_hash_map(il.size()) {
+        insert(il.begin(), il.end());
+    }
+    flat_hash_map(const flat_hash_map& rhs);
+    flat_hash_map(flat_hash_map&& rhs) noexcept
+        : mCtrl(std::move(rhs.mCtrl)),
+          mSlots(std::move(rhs.mSlots)),
+          mSize(std::exchange(rhs.mSize, 0)),
+          mGrowthLeft(std::exchange(rhs.mGrowthLeft, 0)),
+          mHash(rhs.mHash),
+          mEqual(rhs.mEqual) {}
+    flat_hash_map& operator=(flat_hash_map rhs) noexcept {
+        swap(rhs);
+        return *this;
+    }
+    ~flat_hash_map() { destroy_elements(); }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(mSlots.get_allocator());
+    }
+
+    size_t size() const noexcept { return mSize; }
+    bool empty() const noexcept { return mSize == 0; }
+    // The number of slots, a power of two.
+    size_t capacity() const noexcept { return mCtrl.size(); }
+    float load_factor() const noexcept {
+        return capacity() ? float(mSize) / capacity() : 0;
+    }
+    static constexpr float max_load_factor() noexcept { return 0.875f; }
+    // Makes room for n elements without rehashing.
+    void reserve(size_t n);
+    void clear() noexcept;
+    void swap(flat_hash_map& rhs) noexcept;
+    hasher hash_function() const { return mHash; }
+    key_equal key_eq() const { return mEqual; }
+
+    iterator begin() { return iterator_at(0); }
+    const_iterator begin() const { return iterator_at(0); }
+    iterator end() { return iterator(this, capacity()); }
+    const_iterator end() const { return const_iterator(this, capacity()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator find(const Key& key) { return iterator(this, find_index(key)); }
+    const_iterator find(const Key& key) const {
+        return const_iterator(this, find_index(key));
+    }
+    template <typename K>
+        requires transparent
+    iterator find(const K& key) {
+        return iterator(this, find_index(key));
+    }
+    template <typename K>
+        requires transparent
+    const_iterator find(const K& key) const {
+        return const_iterator(this, find_index(key));
+    }
+    bool contains(const Key& key) const {
+        return find_index(key) != capacity();
+    }
+    template <typename K>
+        requires transparent
+    bool contains(const K& key) const {
+        return find_index(key) != capacity();
+    }
+    size_t count(const Key& key) const { return contains(key); }
+    template <typename K>
+        requires transparent
+    size_t count(const K& key) const {
+        return contains(key);
+    }
+
+    // Throws out_of_range if there is no element with key.
+    T& at(const Key& key) { return slot_at(checked_index(key)).second; }
+    const T& at(const Key& key) const {
+        return slot_at(checked_index(key)).second;
+    }
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+    T& operator[](Key&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(value.first, std::move(value.second));
+    }
+    template <detail::legacy_input_iterator InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void insert(std::initializer_list<value_type> il) {
+        insert(il.begin(), il.end());
+    }
+    // Builds the value only if there is no element with key yet.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+    template <class K, class M>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& value);
+
+    // Returns the iterator to the next element.
+    iterator erase(const_iterator position);
+    size_t erase(const Key& key) {
+        const size_t index = find_index(key);
+        if (index == capacity()) {
+            return 0;
+        }
+        erase_index(index);
+        return 1;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+        typedef std::conditional_t<Const, const flat_hash_map, flat_hash_map>
+            map_type;
+
+       public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<const Key, T> value_type;
+        typedef ptrdiff_t difference_type;
+        typedef std::conditional_t<Const, const value_type, value_type>*
+            pointer;
+        typedef std::conditional_t<Const, const value_type, value_type>&
+            reference;
+
+        basic_iterator() = default;
+        // index must be a full slot or the capacity
+        basic_iterator(map_type* map, size_t index)
+            : mMap(map), mIndex(index) {}
+        // iterator to const_iterator
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        basic_iterator(const basic_iterator<OtherConst>& rhs)
+            : mMap(rhs.mMap), mIndex(rhs.mIndex) {}
+
+        reference operator*() const { return mMap->slot_at(mIndex); }
+        pointer operator->() const { return &mMap->slot_at(mIndex); }
+        basic_iterator& operator++() {
+            mIndex = mMap->next_full(mIndex + 1);
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++*this;
+            return retval;
+        }
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) {
+            return lhs.mIndex == rhs.mIndex;
+        }
+
+       private:
+        friend class flat_hash_map;
+        friend class basic_iterator<true>;
+
+        map_type* mMap = nullptr;
+        size_t mIndex = 0;
+    };
+
+   private:
+    value_type& slot_at(size_t index) { return mSlots[index].value; }
+    const value_type& slot_at(size_t index) const {
+        return mSlots[index].value;
+    }
+    // The first full slot from index on, or the capacity.
+    size_t next_full(size_t index) const {
+        while (index < capacity() && mCtrl[index] < 0) {
+            ++index;
+        }
+        return index;
+    }
+    iterator iterator_at(size_t index) {
+        return iterator(this, next_full(index));
+    }
+    const_iterator iterator_at(size_t index) const {
+        return const_iterator(this, next_full(index));
+    }
+    template <typename K>
+    uint64_t hash_of(const K& key) const {
+        return detail::mix_hash(mHash(key));
+    }
+    // The slot holding key, or the capacity.
+    template <typename K>
+    size_t find_index(const K& key, uint64_t hash) const;
+    template <typename K>
+    size_t find_index(const K& key) const {
+        return find_index(key, hash_of(key));
+    }
+    // The first empty or deleted slot on the probe sequence of hash.
+    static size_t find_free(const int8_t* ctrl, size_t capacity,
+                            uint64_t hash);
+    size_t checked_index(const Key& key) const {
+        const size_t index = find_index(key);
+        if (index == capacity()) {
+            throw std::out_of_range(".at(): Invalid key!");
+        }
+        return index;
+    }
+    // The slot for a new element with hash, rehashing if it is needed.
+    size_t prepare_insert(uint64_t hash);
+    void erase_index(size_t index) noexcept;
+    void rehash(size_t capacity);
+    void destroy_elements() noexcept;
+    static size_t growth_limit(size_t capacity) {
+        return capacity - capacity / 8;
+    }
+    // The limit on full slots and tombstones together.
+    static size_t occupancy_limit(size_t capacity) {
+        return capacity - capacity / 16;
+    }
+    static int8_t h2(uint64_t hash) { return int8_t(hash & 0x7f); }
+
+    vector<int8_t, ctrl_allocator> mCtrl;
+    vector<slot_type, slot_allocator> mSlots;
+    size_t mSize = 0;
+    // Empty slots that may still be filled before tombstones are cleared.
+    size_t mGrowthLeft = 0;
+    [[no_unique_address]] Hash mHash;
+    [[no_unique_address]] KeyEqual mEqual;
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::flat_hash_map(
+    const flat_hash_map& rhs)
+    : mCtrl(std::allocator_traits<ctrl_allocator>::
+                select_on_container_copy_construction(
+                    rhs.mCtrl.get_allocator())),
+      mSlots(std::allocator_traits<slot_allocator>::
+                 select_on_container_copy_construction(
+                     rhs.mSlots.get_allocator())),
+      mHash(rhs.mHash),
+      mEqual(rhs.mEqual) {
+    reserve(rhs.size());
+    for (const value_type& value : rhs) {
+        insert(value);
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::reserve(size_t n) {
+    if (n > growth_limit(capacity())) {
+        // the smallest power of two of which n is at most 7/8
+        rehash(std::bit_ceil(std::max(detail::group_width, n + (n + 6) / 7)));
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::clear() noexcept {
+    destroy_elements();
+    std::fill_n(mCtrl.data(), mCtrl.size(), detail::ctrl_empty);
+    mSize = 0;
+    mGrowthLeft = occupancy_limit(capacity());
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::swap(
+    flat_hash_map& rhs) noexcept {
+    using std::swap;
+    mCtrl.swap(rhs.mCtrl);
+    mSlots.swap(rhs.mSlots);
+    swap(mSize, rhs.mSize);
+    swap(mGrowthLeft, rhs.mGrowthLeft);
+    swap(mHash, rhs.mHash);
+    swap(mEqual, rhs.mEqual);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <class K, class... Args>
+std::pair<typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::try_emplace(K&& key,
+                                                              Args&&... args) {
+    const uint64_t hash = hash_of(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity()) {
+        return {iterator(this, index), false};
+    }
+    index = prepare_insert(hash);
+    new (&mSlots[index].value)
+        value_type(std::piecewise_construct,
+                   std::forward_as_tuple(std::forward<K>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+    mGrowthLeft -= mCtrl[index] == detail::ctrl_empty;
+    mCtrl[index] = h2(hash);
+    ++mSize;
+    return {iterator(this, index), true};
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <class K, class M>
+std::pair<typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(
+    K&& key, M&& value) {
+    auto result = try_emplace(std::forward<K>(key), std::forward<M>(value));
+    if (!result.second) {
+        result.first->second = std::forward<M>(value);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(
+    const_iterator position) {
+    erase_index(position.mIndex);
+    return iterator_at(position.mIndex + 1);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K>
+size_t flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::find_index(
+    const K& key, uint64_t hash) const {
+    if (mSize == 0) {
+        return capacity();
+    }
+    const size_t mask = capacity() / detail::group_width - 1;
+    size_t group = (hash >> 7) & mask;
+    for (size_t step = 1;; ++step) {
+        const size_t first = group * detail::group_width;
+        const detail::ctrl_group ctrl(mCtrl.data() + first);
+        for (uint32_t match = ctrl.match(h2(hash)); match;
+             match &= match - 1) {
+            const size_t index = first + std::countr_zero(match);
+            if (mEqual(slot_at(index).first, key)) {
+                return index;
+            }
+        }
+        // the key would have gone into the empty slot
+        if (ctrl.match_empty()) {
+            return capacity();
+        }
+        group = (group + step) & mask;
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+size_t flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::find_free(
+    const int8_t* ctrl, size_t capacity, uint64_t hash) {
+    const size_t mask = capacity / detail::group_width - 1;
+    size_t group = (hash >> 7) & mask;
+    for (size_t step = 1;; ++step) {
+        const size_t first = group * detail::group_width;
+        if (uint32_t free = detail::ctrl_group(ctrl + first).match_free()) {
+            return first + std::countr_zero(free);
+        }
+        group = (group + step) & mask;
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+size_t flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::prepare_insert(
+    uint64_t hash) {
+    if (capacity() == 0) {
+        rehash(detail::group_width);
+    } else if (mSize == growth_limit(capacity())) {
+        rehash(2 * capacity());
+    }
+    size_t index = find_free(mCtrl.data(), capacity(), hash);
+    if (mGrowthLeft == 0 && mCtrl[index] == detail::ctrl_empty) {
+        // the free room went to tombstones: clear them in place
+        rehash(capacity());
+        index = find_free(mCtrl.data(), capacity(), hash);
+    }
+    return index;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::erase_index(
+    size_t index) noexcept {
+    slot_at(index).~value_type();
+    --mSize;
+    // Lookups stop at the first group with an empty slot. If this group
+    // has one, none of them ever went past it and the slot can be empty
+    // again; otherwise it must stay a tombstone for them to go on.
+    const size_t first = index / detail::group_width * detail::group_width;
+    if (detail::ctrl_group(mCtrl.data() + first).match_empty()) {
+        mCtrl[index] = detail::ctrl_empty;
+        ++mGrowthLeft;
+    } else {
+        mCtrl[index] = detail::ctrl_deleted;
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::rehash(size_t capacity) {
+    vector<int8_t, ctrl_allocator> ctrl(capacity, detail::ctrl_empty,
+                                        mCtrl.get_allocator());
+    vector<slot_type, slot_allocator> slots(capacity, default_init,
+                                            mSlots.get_allocator());
+    try {
+        for (size_t i = 0; i < this->capacity(); ++i) {
+            if (mCtrl[i] >= 0) {
+                value_type& value = slot_at(i);
+                const uint64_t hash = hash_of(value.first);
+                const size_t index = find_free(ctrl.data(), capacity, hash);
+                new (&slots[index].value)
+                    value_type(std::move_if_noexcept(value));
+                ctrl[index] = h2(hash);
+            }
+        }
+    } catch (...) {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                slots[i].value.~value_type();
+            }
+        }
+        throw;
+    }
+    destroy_elements();
+    mCtrl.swap(ctrl);
+    mSlots.swap(slots);
+    mGrowthLeft = occupancy_limit(capacity) - mSize;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual,
+          typename Allocator>
+void
+flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::destroy_elements() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (mCtrl[i] >= 0) {
+                slot_at(i).~value_type();
+            }
+        }
+    }
+}
+
+}  // namespace cpp::common::container
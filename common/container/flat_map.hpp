@@ -0,0 +1,486 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flat_set.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+/*
+ * A map kept as two parallel arrays: the keys, sorted and unique, and the
+ * mapped values at the same indices. A lookup binary-searches the keys
+ * alone, so it touches no values until it has found its entry, and a scan
+ * of the values is a scan of one array. For read-mostly tables of a few
+ * thousand entries this is much faster than std::map; insertion and
+ * erasure shift the entries behind the position and are linear.
+ *
+ * Ranges are inserted in bulk: they are appended, sorted and merged with
+ * the existing entries in one pass. replace() adopts already sorted
+ * arrays without copying, extract() hands them back.
+ *
+ * Iterators yield std::pair<const Key&, T&> by value; they are random
+ * access, but only input iterators to algorithms that need real
+ * references. Insertion and erasure invalidate all of them. Of several
+ * entries with equivalent keys the one inserted first is kept. If a bulk
+ * insert throws while the new entries are appended or sorted, the map
+ * keeps its old entries; if it throws while merging them, the map is left
+ * empty.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename KeyContainer = vector<Key>,
+          typename MappedContainer = vector<T>>
+class flat_map {
+   public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef KeyContainer key_container_type;
+    typedef MappedContainer mapped_container_type;
+    typedef std::pair<const Key&, T&> reference;
+    typedef std::pair<const Key&, const T&> const_reference;
+
+    struct containers {
+        KeyContainer keys;
+        MappedContainer values;
+    };
+
+    template <bool Const>
+    class basic_iterator;
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+    flat_map() = default;
+    explicit flat_map(const Compare& comp) : mComp(comp) {}
+    // Sorts the entries by key and drops those with duplicate keys.
+    flat_map(KeyContainer keys, MappedContainer values,
+             const Compare& comp = Compare());
+    flat_map(sorted_unique_t, KeyContainer keys, MappedContainer values,
+             const Compare& comp = Compare())
+        : mKeys(std::move(keys)), mValues(std::move(values)), mComp(comp) {}
+    template <detail::legacy_input_iterator InputIterator>
+    flat_map(InputIterator first, InputIterator last,
+             const Compare& comp = Compare())
+        : mComp(comp) {
+        insert(first, last);
+    }
+    flat_map(std::initializer_list<value_type> il,
+             const Compare& comp = Compare())
+        : flat_map(il.begin(), il.end(), comp) {}
+
+    size_t size() const noexcept { return mKeys.size(); }
+    bool empty() const noexcept { return mKeys.empty(); }
+    void reserve(size_t n) {
+        mKeys.reserve(n);
+        mValues.reserve(n);
+    }
+    void clear() noexcept {
+        mKeys.clear();
+        mValues.clear();
+    }
+    key_compare key_comp() const { return mComp; }
+    const KeyContainer& keys() const noexcept { return mKeys; }
+    const MappedContainer& values() const noexcept { return mValues; }
+
+    iterator begin() { return iterator_at(0); }
+    const_iterator begin() const { return iterator_at(0); }
+    iterator end() { return iterator_at(size()); }
+    const_iterator end() const { return iterator_at(size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator lower_bound(const Key& key) {
+        return iterator_at(lower_index(key));
+    }
+    const_iterator lower_bound(const Key& key) const {
+        return iterator_at(lower_index(key));
+    }
+    iterator upper_bound(const Key& key) {
+        return iterator_at(upper_index(key));
+    }
+    const_iterator upper_bound(const Key& key) const {
+        return iterator_at(upper_index(key));
+    }
+    iterator find(const Key& key) { return iterator_at(find_index(key)); }
+    const_iterator find(const Key& key) const {
+        return iterator_at(find_index(key));
+    }
+    bool contains(const Key& key) const { return find_index(key) != size(); }
+    size_t count(const Key& key) const { return contains(key); }
+
+    // Throws out_of_range if there is no entry for key.
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+    T& operator[](Key&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry) {
+        return try_emplace(entry.first, entry.second);
+    }
+    std::pair<iterator, bool> insert(value_type&& entry) {
+        return try_emplace(std::move(entry.first), std::move(entry.second));
+    }
+    // Builds the value only if there is no entry for key yet.
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+    template <class K, class M>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& value);
+    // Appends the range, sorts it and merges it in one pass.
+    template <detail::legacy_input_iterator InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    // As above for a range that is sorted_unique, which skips the sort.
+    template <detail::legacy_input_iterator InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> il) {
+        insert(il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last);
+    size_t erase(const Key& key) {
+        const size_t index = find_index(key);
+        if (index == size()) {
+            return 0;
+        }
+        erase(iterator_at(index));
+        return 1;
+    }
+
+    /*
+     * Takes over keys and values in place of the current entries. keys must
+     * be sorted by key_comp() and free of duplicates, with the value of
+     * keys[i] at values[i]. Nothing is copied.
+     */
+    void replace(KeyContainer&& keys, MappedContainer&& values) noexcept {
+        mKeys = std::move(keys);
+        mValues = std::move(values);
+    }
+    // Moves the arrays out, leaving the map empty.
+    containers extract() && {
+        containers extracted{std::move(mKeys), std::move(mValues)};
+        clear();
+        return extracted;
+    }
+
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) {
+        return lhs.mKeys == rhs.mKeys && lhs.mValues == rhs.mValues;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+        typedef std::conditional_t<Const, const flat_map, flat_map> map_type;
+        typedef std::conditional_t<Const, const T, T> mapped;
+
+       public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::random_access_iterator_tag iterator_concept;
+        typedef std::pair<Key, T> value_type;
+        typedef ptrdiff_t difference_type;
+        typedef std::pair<const Key&, mapped&> reference;
+        // What operator-> returns: the pair, kept alive for the expression.
+        struct pointer {
+            reference pair;
+            const reference* operator->() const { return &pair; }
+        };
+
+        basic_iterator() = default;
+        basic_iterator(map_type* map, size_t index)
+            : mMap(map), mIndex(index) {}
+        // iterator to const_iterator
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        basic_iterator(const basic_iterator<OtherConst>& rhs)
+            : mMap(rhs.mMap), mIndex(rhs.mIndex) {}
+
+        size_t index() const { return mIndex; }
+
+        reference operator*() const {
+            return {mMap->mKeys[mIndex], mMap->mValues[mIndex]};
+        }
+        pointer operator->() const { return {**this}; }
+        reference operator[](difference_type dist) const {
+            return *(*this + dist);
+        }
+        basic_iterator& operator++() {
+            ++mIndex;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator retval = *this;
+            ++mIndex;
+            return retval;
+        }
+        basic_iterator& operator--() {
+            --mIndex;
+            return *this;
+        }
+        basic_iterator operator--(int) {
+            basic_iterator retval = *this;
+            --mIndex;
+            return retval;
+        }
+        basic_iterator& operator+=(difference_type dist) {
+            mIndex += dist;
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type dist) {
+            mIndex -= dist;
+            return *this;
+        }
+        friend basic_iterator operator+(basic_iterator iter,
+                                        difference_type dist) {
+            return iter += dist;
+        }
+        friend basic_iterator operator+(difference_type dist,
+                                        basic_iterator iter) {
+            return iter += dist;
+        }
+        friend basic_iterator operator-(basic_iterator iter,
+                                        difference_type dist) {
+            return iter -= dist;
+        }
+        friend difference_type operator-(const basic_iterator& lhs,
+                                         const basic_iterator& rhs) {
+            return difference_type(lhs.mIndex) - difference_type(rhs.mIndex);
+        }
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) {
+            return lhs.mIndex == rhs.mIndex;
+        }
+        friend std::strong_ordering operator<=>(const basic_iterator& lhs,
+                                                const basic_iterator& rhs) {
+            return lhs.mIndex <=> rhs.mIndex;
+        }
+
+       private:
+        friend class basic_iterator<true>;
+
+        map_type* mMap = nullptr;
+        size_t mIndex = 0;
+    };
+
+   private:
+    iterator iterator_at(size_t index) { return iterator(this, index); }
+    const_iterator iterator_at(size_t index) const {
+        return const_iterator(this, index);
+    }
+    size_t lower_index(const Key& key) const {
+        return detail::branchless_lower_bound(mKeys.begin(), mKeys.size(),
+                                              key, mComp) -
+               mKeys.begin();
+    }
+    size_t upper_index(const Key& key) const {
+        return detail::branchless_upper_bound(mKeys.begin(), mKeys.size(),
+                                              key, mComp) -
+               mKeys.begin();
+    }
+    // The index of the entry for key, or size() if there is none.
+    size_t find_index(const Key& key) const {
+        const size_t index = lower_index(key);
+        return index != size() && !mComp(key, mKeys[index]) ? index : size();
+    }
+    /*
+     * Sorts the entries from index old_size on by key and merges them with
+     * the sorted entries before it into new arrays, dropping entries whose
+     * key is already taken.
+     */
+    void merge_tail(size_t old_size, bool sorted = false);
+    // Drops the entries from index n on, and a key appended without value.
+    void truncate(size_t n) noexcept {
+        mKeys.erase(mKeys.begin() + n, mKeys.end());
+        mValues.erase(mValues.begin() + n, mValues.end());
+    }
+
+    KeyContainer mKeys;
+    MappedContainer mValues;
+    [[no_unique_address]] Compare mComp;
+};
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(
+    KeyContainer keys, MappedContainer values, const Compare& comp)
+    : mKeys(std::move(keys)), mValues(std::move(values)), mComp(comp) {
+    merge_tail(0);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(
+    const Key& key) {
+    const size_t index = find_index(key);
+    if (index == size()) {
+        throw std::out_of_range(".at(): Invalid key!");
+    }
+    return mValues[index];
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+const T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(
+    const Key& key) const {
+    const size_t index = find_index(key);
+    if (index == size()) {
+        throw std::out_of_range(".at(): Invalid key!");
+    }
+    return mValues[index];
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+template <class K, class... Args>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer,
+                            MappedContainer>::iterator,
+          bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::try_emplace(
+    K&& key, Args&&... args) {
+    const size_t index = lower_index(key);
+    if (index != size() && !mComp(key, mKeys[index])) {
+        return {iterator_at(index), false};
+    }
+    mKeys.insert(mKeys.begin() + index, std::forward<K>(key));
+    try {
+        mValues.emplace(mValues.begin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+        mKeys.erase(mKeys.begin() + index);
+        throw;
+    }
+    return {iterator_at(index), true};
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+template <class K, class M>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer,
+                            MappedContainer>::iterator,
+          bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert_or_assign(
+    K&& key, M&& value) {
+    auto result = try_emplace(std::forward<K>(key), std::forward<M>(value));
+    if (!result.second) {
+        mValues[result.first.index()] = std::forward<M>(value);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+template <detail::legacy_input_iterator InputIterator>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert(
+    InputIterator first, InputIterator last) {
+    const size_t old_size = size();
+    try {
+        for (; first != last; ++first) {
+            const auto& entry = *first;
+            mKeys.push_back(entry.first);
+            mValues.push_back(entry.second);
+        }
+    } catch (...) {
+        truncate(old_size);
+        throw;
+    }
+    merge_tail(old_size);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+template <detail::legacy_input_iterator InputIterator>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert(
+    sorted_unique_t, InputIterator first, InputIterator last) {
+    const size_t old_size = size();
+    try {
+        for (; first != last; ++first) {
+            const auto& entry = *first;
+            mKeys.push_back(entry.first);
+            mValues.push_back(entry.second);
+        }
+    } catch (...) {
+        truncate(old_size);
+        throw;
+    }
+    merge_tail(old_size, true);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::erase(
+    const_iterator first, const_iterator last) {
+    const size_t index = first.index();
+    const size_t n = last.index() - index;
+    mKeys.erase(mKeys.begin() + index, mKeys.begin() + index + n);
+    mValues.erase(mValues.begin() + index, mValues.begin() + index + n);
+    return iterator_at(index);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer,
+          typename MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::merge_tail(
+    size_t old_size, bool sorted) {
+    const size_t n = size();
+    if (n == old_size) {
+        return;
+    }
+    // the new entries in key order, equivalent keys as inserted
+    vector<size_t> order;
+    KeyContainer keys;
+    MappedContainer values;
+    try {
+        order.resize(n - old_size);
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = old_size + i;
+        }
+        if (!sorted) {
+            std::stable_sort(order.begin(), order.end(),
+                             [this](size_t lhs, size_t rhs) {
+                                 return mComp(mKeys[lhs], mKeys[rhs]);
+                             });
+        }
+        keys.reserve(n);
+        values.reserve(n);
+    } catch (...) {
+        // nothing has been moved out of the entries yet
+        truncate(old_size);
+        throw;
+    }
+    try {
+        // Entries come out sorted, so one whose key is not greater than
+        // the last taken has a duplicate key.
+        auto take = [&](size_t index) {
+            if (keys.empty() || mComp(keys.back(), mKeys[index])) {
+                keys.push_back(std::move(mKeys[index]));
+                values.push_back(std::move(mValues[index]));
+            }
+        };
+        size_t old = 0;
+        auto next = order.begin();
+        while (old < old_size || next != order.end()) {
+            if (next == order.end() ||
+                (old < old_size && !mComp(mKeys[*next], mKeys[old]))) {
+                take(old++);
+            } else {
+                take(*next++);
+            }
+        }
+        mKeys = std::move(keys);
+        mValues = std::move(values);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+}  // namespace cpp::common::container
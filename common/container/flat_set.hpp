@@ -0,0 +1,258 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+/*
+ * Tag for the flat_set and flat_map overloads that take elements already
+ * sorted by the container's comparison and free of duplicates, which skip
+ * the sort.
+ */
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail {
+
+/*
+ * The first of the n elements from first on for which comp(element, key)
+ * is false, with std::lower_bound's result. The search halves the range
+ * with a conditional move instead of a branch: every lookup in a range of
+ * a given size takes the same path, so there are no mispredictions to pay
+ * for, and the loads of the next step may start before the comparison of
+ * the current one is done.
+ */
+template <typename RandomAccessIterator, typename Key, typename Compare>
+RandomAccessIterator branchless_lower_bound(RandomAccessIterator first,
+                                            size_t n, const Key& key,
+                                            Compare& comp) {
+    if (n == 0) {
+        return first;
+    }
+    while (n > 1) {
+        const size_t half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+    }
+    return first + comp(*first, key);
+}
+
+// The upper bound, as the lower bound under !comp(key, element).
+template <typename RandomAccessIterator, typename Key, typename Compare>
+RandomAccessIterator branchless_upper_bound(RandomAccessIterator first,
+                                            size_t n, const Key& key,
+                                            Compare& comp) {
+    auto not_after = [&](const auto& element, const Key& k) {
+        return !comp(k, element);
+    };
+    return branchless_lower_bound(first, n, key, not_after);
+}
+
+}  // namespace detail
+
+/*
+ * A set kept as a sorted array of unique keys. Lookups are binary searches
+ * over contiguous memory, which beats the pointer chasing of a node-based
+ * std::set for read-mostly tables of up to a few thousand keys; insertion
+ * and erasure shift the keys behind the position and are linear.
+ *
+ * Ranges are inserted in bulk: they are appended, sorted and merged with
+ * the existing keys in one pass. replace() adopts an already sorted
+ * container without copying, extract() hands it back.
+ *
+ * Insertion and erasure invalidate all iterators. Of several equivalent
+ * keys the one inserted first is kept. If a bulk insert throws while the
+ * new keys are appended or sorted, the set keeps its old keys; if it
+ * throws while merging them, the set is left empty.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename KeyContainer = vector<Key>>
+class flat_set {
+   public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef KeyContainer container_type;
+    typedef typename KeyContainer::const_iterator iterator;
+    typedef typename KeyContainer::const_iterator const_iterator;
+
+    flat_set() = default;
+    explicit flat_set(const Compare& comp) : mComp(comp) {}
+    // Sorts keys and drops duplicates.
+    explicit flat_set(KeyContainer keys, const Compare& comp = Compare())
+        : mKeys(std::move(keys)), mComp(comp) {
+        merge_tail(0);
+    }
+    flat_set(sorted_unique_t, KeyContainer keys,
+             const Compare& comp = Compare())
+        : mKeys(std::move(keys)), mComp(comp) {}
+    template <detail::legacy_input_iterator InputIterator>
+    flat_set(InputIterator first, InputIterator last,
+             const Compare& comp = Compare())
+        : mComp(comp) {
+        insert(first, last);
+    }
+    flat_set(std::initializer_list<Key> il, const Compare& comp = Compare())
+        : flat_set(il.begin(), il.end(), comp) {}
+
+    size_t size() const noexcept { return mKeys.size(); }
+    bool empty() const noexcept { return mKeys.empty(); }
+    void reserve(size_t n) { mKeys.reserve(n); }
+    void clear() noexcept { mKeys.clear(); }
+    key_compare key_comp() const { return mComp; }
+
+    const_iterator begin() const { return mKeys.begin(); }
+    const_iterator end() const { return mKeys.end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    const_iterator lower_bound(const Key& key) const {
+        return detail::branchless_lower_bound(mKeys.begin(), mKeys.size(),
+                                              key, mComp);
+    }
+    const_iterator upper_bound(const Key& key) const {
+        return detail::branchless_upper_bound(mKeys.begin(), mKeys.size(),
+                                              key, mComp);
+    }
+    const_iterator find(const Key& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && !mComp(key, *it) ? it : end();
+    }
+    bool contains(const Key& key) const { return find(key) != end(); }
+    size_t count(const Key& key) const { return contains(key); }
+
+    std::pair<iterator, bool> insert(const Key& key) { return emplace(key); }
+    std::pair<iterator, bool> insert(Key&& key) {
+        return emplace(std::move(key));
+    }
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    // Appends the range, sorts it and merges it in one pass.
+    template <detail::legacy_input_iterator InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    // As above for a range that is sorted_unique, which skips the sort.
+    template <detail::legacy_input_iterator InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last);
+    void insert(std::initializer_list<Key> il) {
+        insert(il.begin(), il.end());
+    }
+
+    iterator erase(const_iterator position) { return mKeys.erase(position); }
+    iterator erase(const_iterator first, const_iterator last) {
+        return mKeys.erase(first, last);
+    }
+    size_t erase(const Key& key) {
+        const_iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        mKeys.erase(it);
+        return 1;
+    }
+
+    /*
+     * Takes over keys, which must be sorted by key_comp() and free of
+     * duplicates, in place of the current ones. Nothing is copied.
+     */
+    void replace(KeyContainer&& keys) noexcept { mKeys = std::move(keys); }
+    // Moves the keys out, leaving the set empty.
+    KeyContainer extract() && {
+        KeyContainer keys = std::move(mKeys);
+        mKeys.clear();
+        return keys;
+    }
+
+    friend bool operator==(const flat_set& lhs, const flat_set& rhs) {
+        return lhs.mKeys == rhs.mKeys;
+    }
+
+   private:
+    /*
+     * Sorts the keys from index old_size on and merges them with the sorted
+     * keys before it, dropping duplicates.
+     */
+    void merge_tail(size_t old_size, bool sorted = false);
+
+    KeyContainer mKeys;
+    [[no_unique_address]] Compare mComp;
+};
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <class... Args>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, bool>
+flat_set<Key, Compare, KeyContainer>::emplace(Args&&... args) {
+    Key key(std::forward<Args>(args)...);
+    const_iterator it = lower_bound(key);
+    if (it != end() && !mComp(key, *it)) {
+        return {it, false};
+    }
+    return {mKeys.insert(it, std::move(key)), true};
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <detail::legacy_input_iterator InputIterator>
+void flat_set<Key, Compare, KeyContainer>::insert(InputIterator first,
+                                                  InputIterator last) {
+    const size_t old_size = mKeys.size();
+    try {
+        mKeys.insert(mKeys.end(), first, last);
+    } catch (...) {
+        mKeys.erase(mKeys.begin() + old_size, mKeys.end());
+        throw;
+    }
+    merge_tail(old_size);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <detail::legacy_input_iterator InputIterator>
+void flat_set<Key, Compare, KeyContainer>::insert(sorted_unique_t,
+                                                  InputIterator first,
+                                                  InputIterator last) {
+    const size_t old_size = mKeys.size();
+    try {
+        mKeys.insert(mKeys.end(), first, last);
+    } catch (...) {
+        mKeys.erase(mKeys.begin() + old_size, mKeys.end());
+        throw;
+    }
+    merge_tail(old_size, true);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+void flat_set<Key, Compare, KeyContainer>::merge_tail(size_t old_size,
+                                                      bool sorted) {
+    // sorted keys are equivalent exactly when the first is not less
+    auto equivalent = [this](const Key& lhs, const Key& rhs) {
+        return !mComp(lhs, rhs);
+    };
+    if (!sorted) {
+        try {
+            std::stable_sort(mKeys.begin() + old_size, mKeys.end(), mComp);
+        } catch (...) {
+            mKeys.erase(mKeys.begin() + old_size, mKeys.end());
+            throw;
+        }
+    }
+    try {
+        auto middle = mKeys.begin() + old_size;
+        // stable, so of two equivalent keys the older one comes first
+        std::inplace_merge(mKeys.begin(), middle, mKeys.end(), mComp);
+        mKeys.erase(std::unique(mKeys.begin(), mKeys.end(), equivalent),
+                    mKeys.end());
+    } catch (...) {
+        mKeys.clear();
+        throw;
+    }
+}
+
+}  // namespace cpp::common::container
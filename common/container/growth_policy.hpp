@@ -0,0 +1,60 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace cpp::common::container {
+
+/*
+ * A growth policy decides how many elements to allocate when a container
+ * needs room for `required` elements while it has room for `capacity`:
+ *
+ *     static size_t capacity(size_t capacity, size_t required,
+ *                            size_t element_size);
+ *
+ * The result must be at least `required`. shrink_to_fit() asks with a
+ * capacity of 0.
+ */
+
+// Rounds up to the next power of two. Simple and fast, but up to half of a
+// large buffer may stay unused.
+struct power_of_two_growth {
+    static size_t capacity(size_t, size_t required, size_t) {
+        return std::bit_ceil(required);
+    }
+};
+
+// Grows by Numerator / Denominator, e.g. geometric_growth<3, 2> for 1.5x.
+// A factor below the golden ratio lets a later request reuse the memory
+// freed by earlier, smaller buffers.
+template <size_t Numerator, size_t Denominator>
+struct geometric_growth {
+    static_assert(Numerator > Denominator, "the buffer has to grow");
+    static size_t capacity(size_t capacity, size_t required, size_t) {
+        return std::max(required, capacity * Numerator / Denominator);
+    }
+};
+
+/*
+ * Grows by 1.5x and then rounds the buffer up to the size class a
+ * jemalloc/tcmalloc style allocator would hand out anyway: multiples of 16
+ * bytes up to 128 bytes and four classes per power of two above that. The
+ * slack the allocator keeps inside the block becomes usable capacity.
+ */
+struct size_class_growth {
+    static size_t round_to_size_class(size_t bytes) {
+        if (bytes <= 128) {
+            return (bytes + 15) & ~size_t(15);
+        }
+        size_t spacing = size_t(1) << (std::bit_width(bytes - 1) - 3);
+        return (bytes + spacing - 1) & ~(spacing - 1);
+    }
+    static size_t capacity(size_t capacity, size_t required,
+                           size_t element_size) {
+        size_t target = std::max(required, capacity + capacity / 2);
+        return round_to_size_class(target * element_size) / element_size;
+    }
+};
+
+}  // namespace cpp::common::container
@@ -0,0 +1,102 @@
+#pragma once
+#include <stddef.h>
+
+#include <compare>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace cpp::common::container::detail {
+
+/*
+ * Random access iterator for containers whose elements are not contiguous
+ * but can be reached by index through Container::operator[]. T is the
+ * element type, const-qualified for const iterators.
+ */
+template <typename Container, typename T>
+class index_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::remove_const_t<T> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    index_iterator() = default;
+    index_iterator(Container* container, size_t index)
+        : mContainer(container), mIndex(index) {}
+    // iterator to const_iterator
+    template <typename OtherContainer, typename U>
+        requires std::is_convertible_v<OtherContainer*, Container*>
+    index_iterator(const index_iterator<OtherContainer, U>& rhs)
+        : mContainer(rhs.container()), mIndex(rhs.index()) {}
+
+    Container* container() const { return mContainer; }
+    size_t index() const { return mIndex; }
+
+    reference operator*() const { return (*mContainer)[mIndex]; }
+    pointer operator->() const { return &(*mContainer)[mIndex]; }
+    reference operator[](difference_type dist) const {
+        return (*mContainer)[mIndex + dist];
+    }
+    index_iterator& operator++() {
+        ++mIndex;
+        return *this;
+    }
+    index_iterator operator++(int) {
+        index_iterator retval = *this;
+        ++mIndex;
+        return retval;
+    }
+    index_iterator& operator--() {
+        --mIndex;
+        return *this;
+    }
+    index_iterator operator--(int) {
+        index_iterator retval = *this;
+        --mIndex;
+        return retval;
+    }
+    index_iterator& operator+=(difference_type dist) {
+        mIndex += dist;
+        return *this;
+    }
+    index_iterator& operator-=(difference_type dist) {
+        mIndex -= dist;
+        return *this;
+    }
+    friend index_iterator operator+(index_iterator iter,
+                                    difference_type dist) {
+        return iter += dist;
+    }
+    friend index_iterator operator+(difference_type dist,
+                                    index_iterator iter) {
+        return iter += dist;
+    }
+    friend index_iterator operator-(index_iterator iter,
+                                    difference_type dist) {
+        return iter -= dist;
+    }
+    friend difference_type operator-(const index_iterator& lhs,
+                                     const index_iterator& rhs) {
+        return difference_type(lhs.mIndex) - difference_type(rhs.mIndex);
+    }
+    friend bool operator==(const index_iterator& lhs,
+                           const index_iterator& rhs) {
+        return lhs.mIndex == rhs.mIndex;
+    }
+    friend std::strong_ordering operator<=>(const index_iterator& lhs,
+                                            const index_iterator& rhs) {
+        return lhs.mIndex <=> rhs.mIndex;
+    }
+    friend void swap(index_iterator& lhs, index_iterator& rhs) noexcept {
+        std::swap(lhs.mContainer, rhs.mContainer);
+        std::swap(lhs.mIndex, rhs.mIndex);
+    }
+
+   private:
+    Container* mContainer = nullptr;
+    size_t mIndex = 0;
+};
+
+}  // namespace cpp::common::container::detail
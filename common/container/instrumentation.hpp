@@ -0,0 +1,189 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace cpp::common::container {
+
+/*
+ * Containers report their allocations to instrumentation_registry when
+ * CPP_CONTAINER_INSTRUMENTATION is defined, e.g. with the CMake option of
+ * the same name. Otherwise every hook is an empty inline function and the
+ * registry stays empty. The macro has to be the same in every translation
+ * unit that instantiates a given container type.
+ */
+#if defined(CPP_CONTAINER_INSTRUMENTATION)
+constexpr bool instrumentation_enabled = true;
+#else
+constexpr bool instrumentation_enabled = false;
+#endif
+
+/*
+ * What one container type did with its buffers, summed over all of its
+ * objects. A buffer is retired when it is freed, handed back or replaced
+ * by a reallocation, at which point its size goes into a histogram of
+ * power-of-two buckets: bucket 0 counts empty buffers and bucket b sizes
+ * in [2^(b-1), 2^b).
+ */
+struct container_stats {
+    static constexpr size_t size_buckets = 65;
+
+    explicit container_stats(std::string name) : name(std::move(name)) {}
+
+    const std::string name;
+    // Buffers obtained from the allocator, including those for growth.
+    std::atomic<uint64_t> allocations = 0;
+    // Times the elements moved to a buffer of another capacity.
+    std::atomic<uint64_t> reallocations = 0;
+    // Bytes of elements copied or moved by those reallocations.
+    std::atomic<uint64_t> relocated_bytes = 0;
+    // The largest buffer any object of the type had.
+    std::atomic<uint64_t> peak_capacity_bytes = 0;
+    std::atomic<uint64_t> retired = 0;
+    // Capacity that was never used by the time buffers were retired.
+    std::atomic<uint64_t> slack_bytes = 0;
+    std::atomic<uint64_t> final_sizes[size_buckets] = {};
+};
+
+/*
+ * Process-wide list of container_stats, one entry per instrumented
+ * container type, created on first use.
+ */
+class instrumentation_registry {
+   public:
+    static instrumentation_registry& instance() {
+        static instrumentation_registry registry;
+        return registry;
+    }
+
+    container_stats& enroll(std::string name) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.push_back(std::make_unique<container_stats>(std::move(name)));
+        return *mStats.back();
+    }
+    // Calls f(const container_stats&) for every type seen so far.
+    template <typename Function>
+    void for_each(Function&& f) const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (const auto& stats : mStats) {
+            f(*stats);
+        }
+    }
+    // Writes one block per container type in a human readable form.
+    void dump(std::ostream& out) const;
+
+   private:
+    instrumentation_registry() = default;
+
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<container_stats>> mStats;
+};
+
+inline void instrumentation_registry::dump(std::ostream& out) const {
+    for_each([&](const container_stats& stats) {
+        const uint64_t retired = stats.retired;
+        out << stats.name << '\n'
+            << "  allocations " << stats.allocations << ", reallocations "
+            << stats.reallocations << ", relocated_bytes "
+            << stats.relocated_bytes << ", peak_capacity_bytes "
+            << stats.peak_capacity_bytes << '\n'
+            << "  retired " << retired << ", slack_bytes "
+            << stats.slack_bytes << ", slack_bytes_per_buffer "
+            << (retired ? stats.slack_bytes / retired : 0) << '\n'
+            << "  final sizes:";
+        for (size_t b = 0; b < container_stats::size_buckets; ++b) {
+            if (const uint64_t count = stats.final_sizes[b]) {
+                if (b == 0) {
+                    out << " [0]=" << count;
+                } else {
+                    out << " [" << (uint64_t(1) << (b - 1)) << ','
+                        << ((uint64_t(1) << (b - 1)) * 2 - 1) << "]=" << count;
+                }
+            }
+        }
+        out << '\n';
+    });
+}
+
+namespace detail {
+
+template <typename Container>
+std::string type_name() {
+    const char* mangled = typeid(Container).name();
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled =
+        abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (demangled) {
+        std::string name(demangled);
+        free(demangled);
+        return name;
+    }
+#endif
+    return mangled;
+}
+
+template <typename Container>
+container_stats& stats_of() {
+    static container_stats& stats =
+        instrumentation_registry::instance().enroll(type_name<Container>());
+    return stats;
+}
+
+/*
+ * The hooks containers call. Sizes are in bytes, except for the element
+ * count passed to on_retire().
+ */
+template <typename Container>
+void on_allocate(size_t capacity_bytes) {
+    if constexpr (instrumentation_enabled) {
+        container_stats& stats = stats_of<Container>();
+        stats.allocations.fetch_add(1, std::memory_order_relaxed);
+        uint64_t peak = stats.peak_capacity_bytes.load();
+        while (peak < capacity_bytes &&
+               !stats.peak_capacity_bytes.compare_exchange_weak(
+                   peak, capacity_bytes, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+// Called after the allocation of the new buffer has been reported, if
+// there was one.
+template <typename Container>
+void on_reallocate(size_t moved_bytes) {
+    if constexpr (instrumentation_enabled) {
+        container_stats& stats = stats_of<Container>();
+        stats.reallocations.fetch_add(1, std::memory_order_relaxed);
+        stats.relocated_bytes.fetch_add(moved_bytes,
+                                        std::memory_order_relaxed);
+    }
+}
+
+template <typename Container>
+void on_retire(size_t size, size_t slack_bytes) {
+    if constexpr (instrumentation_enabled) {
+        container_stats& stats = stats_of<Container>();
+        stats.retired.fetch_add(1, std::memory_order_relaxed);
+        stats.slack_bytes.fetch_add(slack_bytes, std::memory_order_relaxed);
+        stats.final_sizes[std::bit_width(size)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace detail
+
+}  // namespace cpp::common::container
@@ -0,0 +1,345 @@
+#pragma once
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+enum class map_mode { read_only, read_write };
+
+/*
+ * A vector of trivially copyable records that lives in a file. The file is
+ * the raw array, without any header, and is mapped with mmap so opening it
+ * costs no copy; pages are read in as they are first touched.
+ * In read_write mode the file is created if missing and grows with
+ * ftruncate + mremap when elements are appended. While open, the file may
+ * be longer than size() by the spare capacity; flush() and the destructor
+ * trim it to size() elements. In read_only mode every modifying member
+ * throws std::logic_error, and writing through operator[] or data() faults.
+ * The read interface and the iterator types are those of vector<T>. Any
+ * growth may move the mapping and invalidates pointers and iterators.
+ * Failing system calls throw std::system_error.
+ */
+template <typename T, typename GrowthPolicy = power_of_two_growth>
+class mapped_vector {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "records are stored as raw bytes");
+
+   public:
+    typedef T value_type;
+    typedef typename vector<T>::iterator iterator;
+    typedef typename vector<T>::const_iterator const_iterator;
+
+    explicit mapped_vector(const std::string& path,
+                           map_mode mode = map_mode::read_write);
+    mapped_vector(const mapped_vector&) = delete;
+    mapped_vector(mapped_vector&& rhs) noexcept;
+    ~mapped_vector();
+
+    mapped_vector& operator=(const mapped_vector&) = delete;
+    mapped_vector& operator=(mapped_vector&& rhs) noexcept;
+
+    size_t size() const noexcept { return mSize; }
+    size_t capacity() const noexcept { return mCapacity; }
+    bool empty() const noexcept { return mSize == 0; }
+    map_mode mode() const noexcept { return mMode; }
+
+    T& operator[](size_t n) { return mData[n]; }
+    const T& operator[](size_t n) const { return mData[n]; }
+    // Throws out_of_range if n is not below size().
+    T& at(size_t n);
+    const T& at(size_t n) const;
+    T& front() { return mData[0]; }
+    const T& front() const { return mData[0]; }
+    T& back() { return mData[mSize - 1]; }
+    const T& back() const { return mData[mSize - 1]; }
+    T* data() noexcept { return mData; }
+    const T* data() const noexcept { return mData; }
+
+    iterator begin() { return iterator(mData); }
+    const_iterator begin() const { return const_iterator(mData); }
+    iterator end() { return iterator(mData + mSize); }
+    const_iterator end() const { return const_iterator(mData + mSize); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Grows the file so that n elements fit without remapping.
+    void reserve(size_t n);
+    // New elements are value-initialized.
+    void resize(size_t n);
+    void push_back(const T& val);
+    template <class... Args>
+    T& emplace_back(Args&&... args);
+    // [first, last) must not point into this mapped_vector.
+    template <detail::legacy_input_iterator InputIterator>
+    void append(InputIterator first, InputIterator last);
+    void pop_back();
+    void clear();
+    /*
+     * Trims the file to size() elements and writes the dirty pages back
+     * with msync, so the file is complete even if the process dies
+     * afterwards.
+     */
+    void flush();
+
+   private:
+    void check_writable() const;
+    // Resizes file and mapping to n elements.
+    void remap(size_t n);
+    void grow(size_t required) {
+        if (required > mCapacity) {
+            remap(GrowthPolicy::capacity(mCapacity, required, sizeof(T)));
+        }
+    }
+    void close() noexcept;
+
+    int mFd = -1;
+    T* mData = nullptr;
+    size_t mSize = 0;
+    size_t mCapacity = 0;
+    map_mode mMode = map_mode::read_only;
+};
+
+namespace detail {
+
+[[noreturn]] inline void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace detail
+
+template <typename T, typename GrowthPolicy>
+mapped_vector<T, GrowthPolicy>::mapped_vector(const std::string& path,
+                                              map_mode mode)
+    : mMode(mode) {
+    int flags = mode == map_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+    mFd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (mFd < 0) {
+        detail::throw_errno("mapped_vector: open");
+    }
+    struct stat st;
+    if (fstat(mFd, &st) != 0) {
+        int error = errno;
+        ::close(mFd);
+        errno = error;
+        detail::throw_errno("mapped_vector: fstat");
+    }
+    if (st.st_size % sizeof(T) != 0) {
+        ::close(mFd);
+        throw std::runtime_error(
+            "mapped_vector: file size is not a multiple of the record size");
+    }
+    size_t n = st.st_size / sizeof(T);
+    if (n) {
+        int prot = mode == map_mode::read_only ? PROT_READ
+                                               : PROT_READ | PROT_WRITE;
+        void* address =
+            mmap(nullptr, n * sizeof(T), prot, MAP_SHARED, mFd, 0);
+        if (address == MAP_FAILED) {
+            int error = errno;
+            ::close(mFd);
+            errno = error;
+            detail::throw_errno("mapped_vector: mmap");
+        }
+        mData = (T*)address;
+    }
+    mSize = n;
+    mCapacity = n;
+}
+
+template <typename T, typename GrowthPolicy>
+mapped_vector<T, GrowthPolicy>::mapped_vector(mapped_vector&& rhs) noexcept
+    : mFd(std::exchange(rhs.mFd, -1)),
+      mData(std::exchange(rhs.mData, nullptr)),
+      mSize(std::exchange(rhs.mSize, 0)),
+      mCapacity(std::exchange(rhs.mCapacity, 0)),
+      mMode(rhs.mMode) {}
+
+template <typename T, typename GrowthPolicy>
+mapped_vector<T, GrowthPolicy>::~mapped_vector() {
+    close();
+}
+
+template <typename T, typename GrowthPolicy>
+mapped_vector<T, GrowthPolicy>& mapped_vector<T, GrowthPolicy>::operator=(
+    mapped_vector&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        mFd = std::exchange(rhs.mFd, -1);
+        mData = std::exchange(rhs.mData, nullptr);
+        mSize = std::exchange(rhs.mSize, 0);
+        mCapacity = std::exchange(rhs.mCapacity, 0);
+        mMode = rhs.mMode;
+    }
+    return *this;
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::close() noexcept {
+    if (mFd < 0) {
+        return;
+    }
+    if (mData) {
+        munmap(mData, mCapacity * sizeof(T));
+    }
+    if (mMode == map_mode::read_write && mCapacity != mSize) {
+        // best effort: a failure leaves the spare records in the file
+        (void)ftruncate(mFd, mSize * sizeof(T));
+    }
+    ::close(mFd);
+    mFd = -1;
+    mData = nullptr;
+}
+
+template <typename T, typename GrowthPolicy>
+T& mapped_vector<T, GrowthPolicy>::at(size_t n) {
+    if (n >= mSize) {
+        throw std::out_of_range(".at(): Invalid index!");
+    }
+    return mData[n];
+}
+
+template <typename T, typename GrowthPolicy>
+const T& mapped_vector<T, GrowthPolicy>::at(size_t n) const {
+    if (n >= mSize) {
+        throw std::out_of_range(".at(): Invalid index!");
+    }
+    return mData[n];
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::check_writable() const {
+    if (mMode != map_mode::read_write) {
+        throw std::logic_error("mapped_vector: opened read-only");
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::remap(size_t n) {
+    const size_t old_bytes = mCapacity * sizeof(T);
+    const size_t new_bytes = n * sizeof(T);
+    // the file has to cover the mapping before pages beyond its old end
+    // are touched, and may only shrink once they are unmapped
+    if (new_bytes > old_bytes && ftruncate(mFd, new_bytes) != 0) {
+        detail::throw_errno("mapped_vector: ftruncate");
+    }
+    void* address = nullptr;
+    if (mData && new_bytes) {
+#if defined(__linux__)
+        address = mremap(mData, old_bytes, new_bytes, MREMAP_MAYMOVE);
+#else
+        munmap(mData, old_bytes);
+        mData = nullptr;
+        address = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, mFd, 0);
+#endif
+    } else if (new_bytes) {
+        address = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, mFd, 0);
+    } else if (mData) {
+        munmap(mData, old_bytes);
+    }
+    if (address == MAP_FAILED) {
+        detail::throw_errno("mapped_vector: mremap");
+    }
+    mData = (T*)address;
+    mCapacity = n;
+    if (new_bytes < old_bytes && ftruncate(mFd, new_bytes) != 0) {
+        detail::throw_errno("mapped_vector: ftruncate");
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::reserve(size_t n) {
+    check_writable();
+    if (n > mCapacity) {
+        remap(n);
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::resize(size_t n) {
+    check_writable();
+    grow(n);
+    if (n > mSize) {
+        std::uninitialized_value_construct_n(mData + mSize, n - mSize);
+    }
+    mSize = n;
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::push_back(const T& val) {
+    emplace_back(val);
+}
+
+template <typename T, typename GrowthPolicy>
+template <typename... Args>
+T& mapped_vector<T, GrowthPolicy>::emplace_back(Args&&... args) {
+    check_writable();
+    if (mSize == mCapacity) {
+        // args may refer into the mapping that grow() is about to move
+        T value(std::forward<Args>(args)...);
+        grow(mSize + 1);
+        memcpy((void*)(mData + mSize), &value, sizeof(T));
+    } else {
+        new (mData + mSize) T(std::forward<Args>(args)...);
+    }
+    return mData[mSize++];
+}
+
+template <typename T, typename GrowthPolicy>
+template <detail::legacy_input_iterator InputIterator>
+void mapped_vector<T, GrowthPolicy>::append(InputIterator first,
+                                            InputIterator last) {
+    check_writable();
+    if constexpr (detail::legacy_forward_iterator<InputIterator>) {
+        const size_t n = std::distance(first, last);
+        grow(mSize + n);
+        detail::copy_construct_range(first, last, mData + mSize);
+        mSize += n;
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::pop_back() {
+    check_writable();
+    mSize--;
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::clear() {
+    check_writable();
+    mSize = 0;
+}
+
+template <typename T, typename GrowthPolicy>
+void mapped_vector<T, GrowthPolicy>::flush() {
+    check_writable();
+    if (mCapacity != mSize) {
+        remap(mSize);
+    }
+    if (mData && msync(mData, mSize * sizeof(T), MS_SYNC) != 0) {
+        detail::throw_errno("mapped_vector: msync");
+    }
+}
+
+}  // namespace cpp::common::container
@@ -0,0 +1,158 @@
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+namespace cpp::common::container {
+
+/*
+ * A bump-pointer memory resource. Allocation advances a pointer inside the
+ * current chunk and only falls back to malloc when the chunk is exhausted;
+ * deallocation is a no-op and everything is given back at once by release()
+ * or the destructor. Meant for request-scoped containers whose memory dies
+ * together.
+ * Not thread safe.
+ */
+class monotonic_arena {
+   public:
+    explicit monotonic_arena(size_t initial_chunk_size = 4096)
+        : mNextChunkSize(std::max<size_t>(initial_chunk_size, 64)) {}
+    // Serves allocations from buffer first; buffer is never freed by the
+    // arena.
+    monotonic_arena(void* buffer, size_t size)
+        : mCurrent((char*)buffer),
+          mEnd((char*)buffer + size),
+          mNextChunkSize(std::max<size_t>(2 * size, 64)),
+          mInitialBuffer((char*)buffer),
+          mInitialSize(size) {}
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+    ~monotonic_arena() { release(); }
+
+    void* allocate(size_t bytes, size_t alignment) {
+        auto aligned =
+            ((uintptr_t)mCurrent + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        // aligned + bytes may wrap around for huge sizes
+        if (aligned <= (uintptr_t)mEnd && bytes <= (uintptr_t)mEnd - aligned) {
+            mCurrent = (char*)(aligned + bytes);
+            return (void*)aligned;
+        }
+        return allocate_from_new_chunk(bytes, alignment);
+    }
+
+    // Frees every chunk and rewinds to the initial buffer, if any.
+    void release() noexcept {
+        while (mChunks) {
+            chunk* next = mChunks->next;
+            free(mChunks);
+            mChunks = next;
+        }
+        mCurrent = mInitialBuffer;
+        mEnd = mInitialBuffer + mInitialSize;
+    }
+
+    // Number of bytes obtained from malloc, i.e. excluding the initial
+    // buffer.
+    size_t upstream_bytes() const noexcept {
+        size_t bytes = 0;
+        for (chunk* c = mChunks; c; c = c->next) {
+            bytes += c->size;
+        }
+        return bytes;
+    }
+
+    bool owns(const void* pointer) const noexcept {
+        auto address = (uintptr_t)pointer;
+        if (address >= (uintptr_t)mInitialBuffer &&
+            address < (uintptr_t)mInitialBuffer + mInitialSize) {
+            return true;
+        }
+        for (chunk* c = mChunks; c; c = c->next) {
+            if (address >= (uintptr_t)c && address < (uintptr_t)c + c->size) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+   private:
+    struct chunk {
+        chunk* next;
+        size_t size;
+    };
+
+    void* allocate_from_new_chunk(size_t bytes, size_t alignment) {
+        if (bytes > SIZE_MAX - sizeof(chunk) - alignment) {
+            throw std::bad_alloc();
+        }
+        size_t size =
+            std::max(mNextChunkSize, sizeof(chunk) + bytes + alignment);
+        auto* c = (chunk*)malloc(size);
+        if (!c) {
+            throw std::bad_alloc();
+        }
+        c->next = mChunks;
+        c->size = size;
+        mChunks = c;
+        mCurrent = (char*)(c + 1);
+        mEnd = (char*)c + size;
+        mNextChunkSize = 2 * size;
+        return allocate(bytes, alignment);
+    }
+
+    char* mCurrent = nullptr;
+    char* mEnd = nullptr;
+    size_t mNextChunkSize;
+    chunk* mChunks = nullptr;
+    char* mInitialBuffer = nullptr;
+    size_t mInitialSize = 0;
+};
+
+/*
+ * Stateful allocator drawing from a monotonic_arena. Like the polymorphic
+ * allocators of <memory_resource> it never propagates: a container keeps
+ * its arena for its whole life and a copy is placed in the same arena as
+ * the original.
+ */
+template <typename T>
+class arena_allocator {
+   public:
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    arena_allocator(monotonic_arena& arena) noexcept : mArena(&arena) {}
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& rhs) noexcept
+        : mArena(rhs.arena()) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return (T*)mArena->allocate(n * sizeof(T), alignof(T));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    monotonic_arena* arena() const noexcept { return mArena; }
+
+   private:
+    monotonic_arena* mArena;
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace cpp::common::container
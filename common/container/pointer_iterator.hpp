@@ -0,0 +1,117 @@
+#pragma once
+#include <stddef.h>
+
+#include <compare>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace cpp::common::container::detail {
+
+/*
+ * Contiguous iterator over the elements of a Container that keeps them in
+ * one array. It is a pointer with a type of its own, so that iterators of
+ * different containers do not mix, and models std::contiguous_iterator:
+ * std::to_address() returns the pointer, and the standard algorithms and
+ * std::span treat a range of them as the array it is. T is the element
+ * type, const-qualified for const iterators.
+ */
+template <typename Container, typename T>
+class basic_pointer_iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::contiguous_iterator_tag iterator_concept;
+    typedef std::remove_const_t<T> value_type;
+    typedef T element_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    basic_pointer_iterator() = default;
+    explicit basic_pointer_iterator(T* pointer) : mPointer(pointer) {}
+    // iterator to const_iterator
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    basic_pointer_iterator(const basic_pointer_iterator<Container, U>& rhs)
+        : mPointer(rhs.operator->()) {}
+
+    reference operator*() const { return *mPointer; }
+    pointer operator->() const { return mPointer; }
+    reference operator[](difference_type dist) const {
+        return mPointer[dist];
+    }
+    basic_pointer_iterator& operator++() {
+        ++mPointer;
+        return *this;
+    }
+    basic_pointer_iterator operator++(int) {
+        basic_pointer_iterator retval = *this;
+        ++mPointer;
+        return retval;
+    }
+    basic_pointer_iterator& operator--() {
+        --mPointer;
+        return *this;
+    }
+    basic_pointer_iterator operator--(int) {
+        basic_pointer_iterator retval = *this;
+        --mPointer;
+        return retval;
+    }
+    basic_pointer_iterator& operator+=(difference_type dist) {
+        mPointer += dist;
+        return *this;
+    }
+    basic_pointer_iterator& operator-=(difference_type dist) {
+        mPointer -= dist;
+        return *this;
+    }
+    friend basic_pointer_iterator operator+(basic_pointer_iterator iter,
+                                      difference_type dist) {
+        return iter += dist;
+    }
+    friend basic_pointer_iterator operator+(difference_type dist,
+                                      basic_pointer_iterator iter) {
+        return iter += dist;
+    }
+    friend basic_pointer_iterator operator-(basic_pointer_iterator iter,
+                                      difference_type dist) {
+        return iter -= dist;
+    }
+    friend difference_type operator-(const basic_pointer_iterator& lhs,
+                                     const basic_pointer_iterator& rhs) {
+        return lhs.mPointer - rhs.mPointer;
+    }
+    friend bool operator==(const basic_pointer_iterator& lhs,
+                           const basic_pointer_iterator& rhs) {
+        return lhs.mPointer == rhs.mPointer;
+    }
+    friend std::strong_ordering operator<=>(const basic_pointer_iterator& lhs,
+                                            const basic_pointer_iterator& rhs) {
+        return lhs.mPointer <=> rhs.mPointer;
+    }
+    friend void swap(basic_pointer_iterator& lhs, basic_pointer_iterator& rhs) noexcept {
+        std::swap(lhs.mPointer, rhs.mPointer);
+    }
+
+   private:
+    T* mPointer = nullptr;
+};
+
+#if defined(__GLIBCXX__)
+/*
+ * libstdc++ takes its memmove and memcmp paths in std::copy, std::equal and
+ * the like only for raw pointers and its own __normal_iterator, which it
+ * unwraps; any other contiguous iterator gets an element-wise loop. With
+ * libstdc++ the iterators are therefore __normal_iterator, as those of
+ * std::vector and std::span are, which likewise keeps the iterators of
+ * different containers apart.
+ */
+template <typename Container, typename T>
+using pointer_iterator = __gnu_cxx::__normal_iterator<T*, Container>;
+#else
+template <typename Container, typename T>
+using pointer_iterator = basic_pointer_iterator<Container, T>;
+#endif
+
+}  // namespace cpp::common::container::detail
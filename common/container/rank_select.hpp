@@ -0,0 +1,212 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "bvector.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace cpp::common::container {
+
+namespace detail {
+
+// Index of the set bit of word with n set bits below it. word must have
+// more than n set bits.
+inline unsigned select_in_word(uint64_t word, unsigned n) {
+#if defined(__BMI2__)
+    return std::countr_zero(_pdep_u64(uint64_t(1) << n, word));
+#else
+    unsigned shift = 0;
+    for (unsigned set; n >= (set = std::popcount(word & 0xff)); n -= set) {
+        word >>= 8;
+        shift += 8;
+    }
+    for (; n; --n) {
+        word &= word - 1;
+    }
+    return shift + std::countr_zero(word);
+#endif
+}
+
+}  // namespace detail
+
+/*
+ * A vector<bool> with a rank/select index: rank(i) counts the set bits
+ * before index i in constant time, select(k) finds the set bit with k set
+ * bits before it in close to constant time.
+ *
+ * The index keeps the set bits before every superblock of 4096 bits in 64
+ * bits and those from the superblock to every block of 512 bits in 16
+ * bits, 4.7% on top of the bits. A rank adds the two counts and the
+ * popcounts of at most eight words. For select, the superblock of every
+ * 4096th set bit is sampled, which narrows the binary search over the
+ * superblocks to the few between two samples.
+ *
+ * The bits are only changed through this class, which marks the index
+ * stale; the next query rebuilds it in one pass over the words. That makes
+ * queries after a change non-const in effect: threads that share a
+ * rank_select_vector have to call build() before they query it.
+ */
+template <typename Allocator = malloc_allocator<bool>>
+class rank_select_vector {
+   public:
+    typedef vector<bool, Allocator> bits_type;
+    static constexpr size_t npos = bits_type::npos;
+
+    rank_select_vector() = default;
+    explicit rank_select_vector(bits_type bits) : mBits(std::move(bits)) {}
+
+    const bits_type& bits() const noexcept { return mBits; }
+    size_t size() const noexcept { return mBits.size(); }
+    bool operator[](size_t n) const { return mBits[n]; }
+
+    void set(size_t n, bool val = true) {
+        mBits[n] = val;
+        mStale = true;
+    }
+    void reset(size_t n) { set(n, false); }
+    void push_back(bool val) {
+        mBits.push_back(val);
+        mStale = true;
+    }
+    void resize(size_t n, bool val = false) {
+        mBits.resize(n, val);
+        mStale = true;
+    }
+    // Takes over bits in place of the current ones.
+    void assign(bits_type bits) {
+        mBits = std::move(bits);
+        mStale = true;
+    }
+    // Moves the bits out, leaving the vector empty.
+    bits_type extract() && {
+        bits_type bits = std::move(mBits);
+        mBits.clear();
+        mStale = true;
+        return bits;
+    }
+
+    // Rebuilds the index if the bits changed since it was built.
+    void build() const {
+        if (mStale) {
+            rebuild();
+        }
+    }
+    size_t count() const {
+        build();
+        return mCount;
+    }
+    // The number of set bits before index n, for n up to size().
+    size_t rank(size_t n) const;
+    // The number of clear bits before index n.
+    size_t rank0(size_t n) const { return n - rank(n); }
+    // The index of the set bit with n set bits before it, or npos.
+    size_t select(size_t n) const;
+
+   private:
+    static constexpr size_t block_bits = 512;
+    static constexpr size_t super_bits = 4096;
+    static constexpr size_t block_words = block_bits / detail::bits_per_word;
+    static constexpr size_t blocks_per_super = super_bits / block_bits;
+    // every sample_rate-th set bit has its superblock sampled for select
+    static constexpr size_t sample_rate = 4096;
+
+    void rebuild() const;
+
+    bits_type mBits;
+    // There is a superblock and a block count more than there are whole
+    // superblocks and blocks, so that rank(size()) needs no special case.
+    mutable vector<uint64_t> mSuper;
+    mutable vector<uint16_t> mBlock;
+    mutable vector<uint32_t> mSamples;
+    mutable size_t mCount = 0;
+    mutable bool mStale = true;
+};
+
+template <typename Allocator>
+size_t rank_select_vector<Allocator>::rank(size_t n) const {
+    build();
+    const uint64_t* words = mBits.words();
+    const size_t word = n / detail::bits_per_word;
+    size_t set = mSuper[n / super_bits] + mBlock[n / block_bits];
+    for (size_t i = n / block_bits * block_words; i < word; ++i) {
+        set += std::popcount(words[i]);
+    }
+    if (n % detail::bits_per_word) {
+        set += std::popcount(words[word] & detail::tail_mask(n));
+    }
+    return set;
+}
+
+template <typename Allocator>
+size_t rank_select_vector<Allocator>::select(size_t n) const {
+    build();
+    if (n >= mCount) {
+        return npos;
+    }
+    // the last superblock with at most n set bits before it lies between
+    // the samples around n
+    const size_t sample = n / sample_rate;
+    const auto first = mSuper.begin() + mSamples[sample];
+    const auto last = sample + 1 < mSamples.size()
+                          ? mSuper.begin() + mSamples[sample + 1] + 1
+                          : mSuper.end();
+    const size_t super = std::upper_bound(first, last, n) - mSuper.begin() - 1;
+    n -= mSuper[super];
+
+    size_t block = super * blocks_per_super;
+    const size_t blocks = std::min(block + blocks_per_super, mBlock.size());
+    while (block + 1 < blocks && mBlock[block + 1] <= n) {
+        ++block;
+    }
+    n -= mBlock[block];
+
+    const uint64_t* words = mBits.words();
+    size_t word = block * block_words;
+    for (size_t set; n >= (set = std::popcount(words[word])); n -= set) {
+        ++word;
+    }
+    return word * detail::bits_per_word +
+           detail::select_in_word(words[word], n);
+}
+
+template <typename Allocator>
+void rank_select_vector<Allocator>::rebuild() const {
+    const uint64_t* words = mBits.words();
+    const size_t word_count = mBits.word_count();
+    const size_t blocks = mBits.size() / block_bits + 1;
+    mSuper.clear();
+    mBlock.clear();
+    mSamples.clear();
+    mSuper.reserve(mBits.size() / super_bits + 1);
+    mBlock.reserve(blocks);
+
+    size_t set = 0;
+    for (size_t block = 0; block < blocks; ++block) {
+        if (block % blocks_per_super == 0) {
+            mSuper.push_back(set);
+        }
+        mBlock.push_back(set - mSuper.back());
+        const size_t word = block * block_words;
+        const size_t end = std::min(word + block_words, word_count);
+        set += detail::count_words(words + word, end - word);
+    }
+    mCount = set;
+
+    for (size_t super = 0, next = 0; next < mCount; ++super) {
+        const size_t before_next =
+            super + 1 < mSuper.size() ? mSuper[super + 1] : mCount;
+        for (; next < before_next; next += sample_rate) {
+            mSamples.push_back(super);
+        }
+    }
+    mStale = false;
+}
+
+}  // namespace cpp::common::container
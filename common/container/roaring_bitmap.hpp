@@ -0,0 +1,763 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "bvector.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+namespace detail {
+
+enum class roaring_kind : uint8_t { array, bitmap, run };
+
+// Chunks with more values than this are bitmaps, those with fewer arrays.
+inline constexpr uint32_t roaring_array_max = 4096;
+inline constexpr size_t roaring_chunk_bits = size_t(1) << 16;
+inline constexpr size_t roaring_bitmap_words =
+    roaring_chunk_bits / bits_per_word;
+
+/*
+ * The values of one chunk, those sharing their upper 16 bits key, in one
+ * of three forms:
+ *  - array:  count sorted low halves in values.
+ *  - bitmap: 65536 bits in words, cardinality of them set.
+ *  - run:    count runs in values as (first, last) pairs of low halves.
+ * A view is what roaring_bitmap and roaring_view have in common, whether
+ * the chunk is owned or lies in a serialized bitmap.
+ */
+struct roaring_chunk_view {
+    uint16_t key = 0;
+    roaring_kind kind = roaring_kind::array;
+    uint32_t cardinality = 0;
+    uint32_t count = 0;
+    const uint16_t* values = nullptr;
+    const uint64_t* words = nullptr;
+
+    bool contains(uint16_t low) const {
+        switch (kind) {
+            case roaring_kind::array:
+                return std::binary_search(values, values + count, low);
+            case roaring_kind::bitmap:
+                return words[low / bits_per_word] >> low % bits_per_word & 1;
+            case roaring_kind::run: {
+                // the last run that starts at or before low
+                size_t first = 0, n = count;
+                while (n > 0) {
+                    const size_t half = n / 2;
+                    if (values[2 * (first + half)] <= low) {
+                        first += half + 1;
+                        n -= half + 1;
+                    } else {
+                        n = half;
+                    }
+                }
+                return first > 0 && low <= values[2 * first - 1];
+            }
+        }
+        return false;
+    }
+};
+
+// An owned chunk; values or bits holds the values, depending on kind.
+struct roaring_chunk {
+    uint16_t key = 0;
+    roaring_kind kind = roaring_kind::array;
+    uint32_t cardinality = 0;
+    vector<uint16_t> values;
+    vector<bool> bits;
+
+    roaring_chunk_view view() const {
+        roaring_chunk_view view;
+        view.key = key;
+        view.kind = kind;
+        view.cardinality = cardinality;
+        view.count = kind == roaring_kind::run ? uint32_t(values.size() / 2)
+                                               : uint32_t(values.size());
+        view.values = values.data();
+        view.words = bits.words();
+        return view;
+    }
+};
+
+/*
+ * Forward iterator over the values of a roaring_bitmap or roaring_view,
+ * which give it their chunks through chunk_count() and chunk(i).
+ */
+template <typename Source>
+class roaring_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef uint32_t value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef uint32_t reference;
+
+    roaring_iterator() = default;
+    roaring_iterator(const Source* source, size_t chunk)
+        : mSource(source), mChunk(chunk) {
+        load();
+    }
+
+    uint32_t operator*() const { return uint32_t(mView.key) << 16 | mLow; }
+    roaring_iterator& operator++() {
+        switch (mView.kind) {
+            case roaring_kind::array:
+                if (++mPos < mView.count) {
+                    mLow = mView.values[mPos];
+                    return *this;
+                }
+                break;
+            case roaring_kind::bitmap: {
+                const size_t next = find_bit(mView.words, roaring_chunk_bits,
+                                             mLow + 1, 0);
+                if (next != size_t(-1)) {
+                    mLow = next;
+                    return *this;
+                }
+                break;
+            }
+            case roaring_kind::run:
+                if (mLow < mView.values[2 * mPos + 1]) {
+                    ++mLow;
+                    return *this;
+                }
+                if (++mPos < mView.count) {
+                    mLow = mView.values[2 * mPos];
+                    return *this;
+                }
+                break;
+        }
+        ++mChunk;
+        load();
+        return *this;
+    }
+    roaring_iterator operator++(int) {
+        roaring_iterator retval = *this;
+        ++(*this);
+        return retval;
+    }
+    friend bool operator==(const roaring_iterator& lhs,
+                           const roaring_iterator& rhs) {
+        return lhs.mChunk == rhs.mChunk && lhs.mLow == rhs.mLow;
+    }
+
+   private:
+    // Moves to the first value of chunk mChunk, chunks are never empty.
+    void load() {
+        mPos = 0;
+        mLow = 0;
+        if (mChunk == mSource->chunk_count()) {
+            return;
+        }
+        mView = mSource->chunk(mChunk);
+        if (mView.kind == roaring_kind::bitmap) {
+            mLow = find_bit(mView.words, roaring_chunk_bits, 0, 0);
+        } else {
+            mLow = mView.values[0];
+        }
+    }
+
+    const Source* mSource = nullptr;
+    size_t mChunk = 0;
+    roaring_chunk_view mView;
+    // index of the value or run in the chunk
+    uint32_t mPos = 0;
+    // the low half of the current value
+    uint32_t mLow = 0;
+};
+
+}  // namespace detail
+
+class roaring_view;
+
+/*
+ * A compressed set of 32-bit values in the manner of Roaring bitmaps. The
+ * values are split by their upper 16 bits into chunks, kept sorted by that
+ * key, and each chunk stores the lower halves in whichever form is
+ * smallest:
+ *  - a sorted array of up to 4096 values, 2 bytes per value,
+ *  - a vector<bool> of all 65536 bits, 8 KiB, above 4096 values,
+ *  - runs of consecutive values, 4 bytes per run, after run_optimize().
+ * A sparse set takes about 2 bytes per value instead of the 512 MiB of a
+ * plain bit vector over the 32-bit space.
+ *
+ * Set operations go chunk by chunk. Two bitmap chunks are combined a word
+ * at a time with vector<bool>'s word operators, two arrays are merged, and
+ * an array is intersected with another chunk by testing its values; other
+ * combinations go through bitmaps. Results come out as arrays or bitmaps.
+ * Changing a run chunk turns it back into an array or a bitmap.
+ *
+ * serialize() writes the set as a flat image that roaring_view reads in
+ * place, e.g. from a memory-mapped file, without parsing or copying it.
+ */
+class roaring_bitmap {
+   public:
+    typedef uint32_t value_type;
+    typedef detail::roaring_iterator<roaring_bitmap> iterator;
+    typedef iterator const_iterator;
+
+    roaring_bitmap() = default;
+    roaring_bitmap(std::initializer_list<uint32_t> il)
+        : roaring_bitmap(il.begin(), il.end()) {}
+    template <detail::legacy_input_iterator InputIterator>
+    roaring_bitmap(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            add(*first);
+        }
+    }
+    // Copies a serialized bitmap.
+    explicit roaring_bitmap(const roaring_view& view);
+
+    // Returns whether value was not there yet.
+    bool add(uint32_t value);
+    // Returns whether value was there.
+    bool remove(uint32_t value);
+    bool contains(uint32_t value) const {
+        const size_t i = find_chunk(value >> 16);
+        return i != mChunks.size() && mChunks[i].key == value >> 16 &&
+               mChunks[i].view().contains(uint16_t(value));
+    }
+    size_t cardinality() const noexcept;
+    bool empty() const noexcept { return mChunks.empty(); }
+    void clear() noexcept { mChunks.clear(); }
+    /*
+     * Turns the chunks that are smaller as runs of consecutive values into
+     * run chunks.
+     */
+    void run_optimize();
+
+    roaring_bitmap& operator&=(const roaring_bitmap& rhs) {
+        return *this = combine<detail::bit_and>(*this, rhs);
+    }
+    roaring_bitmap& operator|=(const roaring_bitmap& rhs) {
+        return *this = combine<detail::bit_or>(*this, rhs);
+    }
+    roaring_bitmap& operator^=(const roaring_bitmap& rhs) {
+        return *this = combine<detail::bit_xor>(*this, rhs);
+    }
+    // Removes the values of rhs.
+    roaring_bitmap& andnot(const roaring_bitmap& rhs) {
+        return *this = combine<detail::bit_andnot>(*this, rhs);
+    }
+    friend roaring_bitmap operator&(const roaring_bitmap& lhs,
+                                    const roaring_bitmap& rhs) {
+        return combine<detail::bit_and>(lhs, rhs);
+    }
+    friend roaring_bitmap operator|(const roaring_bitmap& lhs,
+                                    const roaring_bitmap& rhs) {
+        return combine<detail::bit_or>(lhs, rhs);
+    }
+    friend roaring_bitmap operator^(const roaring_bitmap& lhs,
+                                    const roaring_bitmap& rhs) {
+        return combine<detail::bit_xor>(lhs, rhs);
+    }
+    friend bool operator==(const roaring_bitmap& lhs,
+                           const roaring_bitmap& rhs) {
+        return lhs.cardinality() == rhs.cardinality() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const {
+        return const_iterator(this, mChunks.size());
+    }
+
+    /*
+     * The serialized form, in the byte order of the writing machine:
+     *  - a word with the magic number in the low and the chunk count in
+     *    the high 32 bits,
+     *  - two words per chunk, sorted by key: key, kind and cardinality,
+     *    then the offset of the chunk's data in words from the start and
+     *    its number of values or runs,
+     *  - the data of every chunk, padded to whole words.
+     * serialize() writes serialized_size() bytes to out, which has to be
+     * aligned to 8 bytes.
+     */
+    static constexpr uint32_t serialized_magic = 0x314d4252;  // "RBM1"
+    size_t serialized_size() const noexcept;
+    void serialize(void* out) const;
+
+   private:
+    template <typename>
+    friend class detail::roaring_iterator;
+
+    size_t chunk_count() const noexcept { return mChunks.size(); }
+    detail::roaring_chunk_view chunk(size_t i) const {
+        return mChunks[i].view();
+    }
+    // The index of the first chunk whose key is not below key.
+    size_t find_chunk(uint32_t key) const {
+        size_t first = 0, n = mChunks.size();
+        while (n > 0) {
+            const size_t half = n / 2;
+            if (mChunks[first + half].key < key) {
+                first += half + 1;
+                n -= half + 1;
+            } else {
+                n = half;
+            }
+        }
+        return first;
+    }
+
+    template <typename Op>
+    static roaring_bitmap combine(const roaring_bitmap& lhs,
+                                  const roaring_bitmap& rhs);
+
+    vector<detail::roaring_chunk> mChunks;
+};
+
+/*
+ * Read-only access to a serialized roaring_bitmap where it lies, e.g. in
+ * a file mapped with mapped_vector<char> or mmap. Lookups binary search
+ * the chunk table; nothing is copied. The memory has to stay valid and
+ * unchanged for the lifetime of the view.
+ */
+class roaring_view {
+   public:
+    typedef uint32_t value_type;
+    typedef detail::roaring_iterator<roaring_view> iterator;
+    typedef iterator const_iterator;
+
+    roaring_view() = default;
+    /*
+     * data has to be aligned to 8 bytes. Throws std::runtime_error if the
+     * bytes are not a serialized bitmap.
+     */
+    roaring_view(const void* data, size_t bytes);
+
+    bool contains(uint32_t value) const;
+    size_t cardinality() const noexcept;
+    bool empty() const noexcept { return mChunks == 0; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, mChunks); }
+
+   private:
+    template <typename>
+    friend class detail::roaring_iterator;
+    friend class roaring_bitmap;
+
+    size_t chunk_count() const noexcept { return mChunks; }
+    detail::roaring_chunk_view chunk(size_t i) const;
+
+    const uint64_t* mWords = nullptr;
+    size_t mChunks = 0;
+};
+
+namespace detail {
+
+// The number of values or runs of a chunk's data that fit in a word.
+inline size_t roaring_data_words(roaring_kind kind, size_t count) {
+    switch (kind) {
+        case roaring_kind::array:
+            return (count * sizeof(uint16_t) + 7) / 8;
+        case roaring_kind::bitmap:
+            return roaring_bitmap_words;
+        case roaring_kind::run:
+            return (count * 2 * sizeof(uint16_t) + 7) / 8;
+    }
+    return 0;
+}
+
+// The chunk's values as a bitmap.
+inline vector<bool> roaring_bits(const roaring_chunk_view& view) {
+    vector<bool> bits(roaring_chunk_bits);
+    switch (view.kind) {
+        case roaring_kind::array:
+            for (uint32_t i = 0; i < view.count; ++i) {
+                bits[view.values[i]] = true;
+            }
+            break;
+        case roaring_kind::bitmap:
+            memcpy(bits.words(), view.words,
+                   roaring_bitmap_words * sizeof(uint64_t));
+            break;
+        case roaring_kind::run:
+            for (uint32_t i = 0; i < view.count; ++i) {
+                bits.set(view.values[2 * i], view.values[2 * i + 1] + 1);
+            }
+            break;
+    }
+    return bits;
+}
+
+// Turns a bitmap chunk with few values into an array, an array chunk with
+// many values into a bitmap.
+inline void roaring_normalize(roaring_chunk& chunk) {
+    if (chunk.kind == roaring_kind::bitmap &&
+        chunk.cardinality <= roaring_array_max) {
+        chunk.values.resize(chunk.cardinality);
+        uint16_t* out = chunk.values.data();
+        const uint64_t* words = chunk.bits.words();
+        for (size_t i = 0; i < roaring_bitmap_words; ++i) {
+            for (uint64_t word = words[i]; word; word &= word - 1) {
+                *out++ = uint16_t(i * bits_per_word + std::countr_zero(word));
+            }
+        }
+        chunk.bits = vector<bool>();
+        chunk.kind = roaring_kind::array;
+    } else if (chunk.kind == roaring_kind::array &&
+               chunk.values.size() > roaring_array_max) {
+        chunk.bits = roaring_bits(chunk.view());
+        chunk.values = vector<uint16_t>();
+        chunk.kind = roaring_kind::bitmap;
+    }
+}
+
+// Copies the chunk into an array or bitmap chunk.
+inline roaring_chunk roaring_materialize(const roaring_chunk_view& view) {
+    roaring_chunk chunk;
+    chunk.key = view.key;
+    chunk.cardinality = view.cardinality;
+    if (view.kind == roaring_kind::array) {
+        chunk.values.assign(view.values, view.values + view.count);
+    } else {
+        chunk.kind = roaring_kind::bitmap;
+        chunk.bits = roaring_bits(view);
+        roaring_normalize(chunk);
+    }
+    return chunk;
+}
+
+// The values of lhs Op rhs, for the bit_and, bit_or, bit_xor and
+// bit_andnot of bvector.hpp, as an array or bitmap chunk.
+template <typename Op>
+roaring_chunk roaring_combine(const roaring_chunk_view& lhs,
+                              const roaring_chunk_view& rhs) {
+    constexpr bool intersects = std::is_same_v<Op, bit_and>;
+    constexpr bool subtracts = std::is_same_v<Op, bit_andnot>;
+    roaring_chunk result;
+    result.key = lhs.key;
+    if (lhs.kind == roaring_kind::array && rhs.kind == roaring_kind::array) {
+        const uint16_t* first1 = lhs.values;
+        const uint16_t* last1 = lhs.values + lhs.count;
+        const uint16_t* first2 = rhs.values;
+        const uint16_t* last2 = rhs.values + rhs.count;
+        auto out = std::back_inserter(result.values);
+        if constexpr (intersects) {
+            std::set_intersection(first1, last1, first2, last2, out);
+        } else if constexpr (subtracts) {
+            std::set_difference(first1, last1, first2, last2, out);
+        } else if constexpr (std::is_same_v<Op, bit_or>) {
+            std::set_union(first1, last1, first2, last2, out);
+        } else {
+            std::set_symmetric_difference(first1, last1, first2, last2, out);
+        }
+        result.cardinality = result.values.size();
+    } else if ((intersects || subtracts) &&
+               lhs.kind == roaring_kind::array) {
+        // keeps the values of the array that rhs has, or does not have
+        for (uint32_t i = 0; i < lhs.count; ++i) {
+            if (rhs.contains(lhs.values[i]) == intersects) {
+                result.values.push_back(lhs.values[i]);
+            }
+        }
+        result.cardinality = result.values.size();
+    } else if (intersects && rhs.kind == roaring_kind::array) {
+        return roaring_combine<Op>(rhs, lhs);
+    } else {
+        result.kind = roaring_kind::bitmap;
+        result.bits = roaring_bits(lhs);
+        if (rhs.kind == roaring_kind::bitmap) {
+            combine_words(result.bits.words(), rhs.words,
+                          result.bits.word_count(), Op());
+        } else {
+            const vector<bool> bits = roaring_bits(rhs);
+            combine_words(result.bits.words(), bits.words(),
+                          result.bits.word_count(), Op());
+        }
+        result.cardinality = result.bits.count();
+    }
+    roaring_normalize(result);
+    return result;
+}
+
+}  // namespace detail
+
+inline roaring_bitmap::roaring_bitmap(const roaring_view& view) {
+    mChunks.reserve(view.chunk_count());
+    for (size_t i = 0; i < view.chunk_count(); ++i) {
+        const detail::roaring_chunk_view chunk = view.chunk(i);
+        if (chunk.kind == detail::roaring_kind::bitmap) {
+            mChunks.push_back(detail::roaring_materialize(chunk));
+            continue;
+        }
+        detail::roaring_chunk copy;
+        copy.key = chunk.key;
+        copy.kind = chunk.kind;
+        copy.cardinality = chunk.cardinality;
+        const size_t n =
+            chunk.kind == detail::roaring_kind::run ? 2 * chunk.count
+                                                    : chunk.count;
+        copy.values.assign(chunk.values, chunk.values + n);
+        mChunks.push_back(std::move(copy));
+    }
+}
+
+inline bool roaring_bitmap::add(uint32_t value) {
+    const uint16_t key = value >> 16;
+    const uint16_t low = uint16_t(value);
+    size_t i = find_chunk(key);
+    if (i == mChunks.size() || mChunks[i].key != key) {
+        detail::roaring_chunk chunk;
+        chunk.key = key;
+        chunk.cardinality = 1;
+        chunk.values.push_back(low);
+        mChunks.insert(mChunks.begin() + i, std::move(chunk));
+        return true;
+    }
+    detail::roaring_chunk& chunk = mChunks[i];
+    if (chunk.view().contains(low)) {
+        return false;
+    }
+    if (chunk.kind == detail::roaring_kind::run) {
+        chunk = detail::roaring_materialize(chunk.view());
+    }
+    if (chunk.kind == detail::roaring_kind::bitmap) {
+        chunk.bits[low] = true;
+    } else {
+        chunk.values.insert(
+            std::lower_bound(chunk.values.begin(), chunk.values.end(), low),
+            low);
+    }
+    ++chunk.cardinality;
+    detail::roaring_normalize(chunk);
+    return true;
+}
+
+inline bool roaring_bitmap::remove(uint32_t value) {
+    const uint16_t key = value >> 16;
+    const uint16_t low = uint16_t(value);
+    const size_t i = find_chunk(key);
+    if (i == mChunks.size() || mChunks[i].key != key ||
+        !mChunks[i].view().contains(low)) {
+        return false;
+    }
+    detail::roaring_chunk& chunk = mChunks[i];
+    if (chunk.cardinality == 1) {
+        mChunks.erase(mChunks.begin() + i);
+        return true;
+    }
+    if (chunk.kind == detail::roaring_kind::run) {
+        chunk = detail::roaring_materialize(chunk.view());
+    }
+    if (chunk.kind == detail::roaring_kind::bitmap) {
+        chunk.bits[low] = false;
+    } else {
+        chunk.values.erase(
+            std::lower_bound(chunk.values.begin(), chunk.values.end(), low));
+    }
+    --chunk.cardinality;
+    detail::roaring_normalize(chunk);
+    return true;
+}
+
+inline size_t roaring_bitmap::cardinality() const noexcept {
+    size_t n = 0;
+    for (const auto& chunk : mChunks) {
+        n += chunk.cardinality;
+    }
+    return n;
+}
+
+inline void roaring_bitmap::run_optimize() {
+    for (auto& chunk : mChunks) {
+        if (chunk.kind == detail::roaring_kind::run) {
+            continue;
+        }
+        // a run starts at every value whose predecessor is missing
+        size_t runs = 0;
+        if (chunk.kind == detail::roaring_kind::array) {
+            for (size_t i = 0; i < chunk.values.size(); ++i) {
+                runs += i == 0 || chunk.values[i] != chunk.values[i - 1] + 1;
+            }
+        } else {
+            const uint64_t* words = chunk.bits.words();
+            uint64_t carry = 0;
+            for (size_t i = 0; i < detail::roaring_bitmap_words; ++i) {
+                runs += std::popcount(words[i] & ~(words[i] << 1 | carry));
+                carry = words[i] >> 63;
+            }
+        }
+        const size_t size = chunk.kind == detail::roaring_kind::array
+                                ? chunk.values.size() * sizeof(uint16_t)
+                                : detail::roaring_bitmap_words * 8;
+        if (runs * 2 * sizeof(uint16_t) >= size) {
+            continue;
+        }
+        vector<uint16_t> pairs;
+        pairs.reserve(2 * runs);
+        auto it = const_iterator(this, &chunk - mChunks.data());
+        for (uint32_t n = 0; n < chunk.cardinality; ++n, ++it) {
+            const uint16_t low = uint16_t(*it);
+            if (!pairs.empty() && low == pairs.back() + 1) {
+                pairs.back() = low;
+            } else {
+                pairs.push_back(low);
+                pairs.push_back(low);
+            }
+        }
+        chunk.values = std::move(pairs);
+        chunk.bits = vector<bool>();
+        chunk.kind = detail::roaring_kind::run;
+    }
+}
+
+template <typename Op>
+roaring_bitmap roaring_bitmap::combine(const roaring_bitmap& lhs,
+                                       const roaring_bitmap& rhs) {
+    // the chunks of only one side that are part of the result
+    constexpr bool keep_lhs = !std::is_same_v<Op, detail::bit_and>;
+    constexpr bool keep_rhs = std::is_same_v<Op, detail::bit_or> ||
+                              std::is_same_v<Op, detail::bit_xor>;
+    roaring_bitmap result;
+    result.mChunks.reserve(keep_rhs ? lhs.mChunks.size() + rhs.mChunks.size()
+                                    : lhs.mChunks.size());
+    size_t i = 0, j = 0;
+    while (i < lhs.mChunks.size() || j < rhs.mChunks.size()) {
+        if (j == rhs.mChunks.size() ||
+            (i < lhs.mChunks.size() &&
+             lhs.mChunks[i].key < rhs.mChunks[j].key)) {
+            if (keep_lhs) {
+                result.mChunks.push_back(lhs.mChunks[i]);
+            }
+            ++i;
+        } else if (i == lhs.mChunks.size() ||
+                   rhs.mChunks[j].key < lhs.mChunks[i].key) {
+            if (keep_rhs) {
+                result.mChunks.push_back(rhs.mChunks[j]);
+            }
+            ++j;
+        } else {
+            detail::roaring_chunk chunk = detail::roaring_combine<Op>(
+                lhs.mChunks[i].view(), rhs.mChunks[j].view());
+            if (chunk.cardinality) {
+                result.mChunks.push_back(std::move(chunk));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+inline size_t roaring_bitmap::serialized_size() const noexcept {
+    size_t words = 1 + 2 * mChunks.size();
+    for (const auto& chunk : mChunks) {
+        words += detail::roaring_data_words(chunk.kind, chunk.view().count);
+    }
+    return words * sizeof(uint64_t);
+}
+
+inline void roaring_bitmap::serialize(void* out) const {
+    uint64_t* words = (uint64_t*)out;
+    words[0] = serialized_magic | uint64_t(mChunks.size()) << 32;
+    size_t offset = 1 + 2 * mChunks.size();
+    for (size_t i = 0; i < mChunks.size(); ++i) {
+        const detail::roaring_chunk_view chunk = mChunks[i].view();
+        const size_t data_words =
+            detail::roaring_data_words(chunk.kind, chunk.count);
+        words[1 + 2 * i] = chunk.key | uint64_t(chunk.kind) << 16 |
+                           uint64_t(chunk.cardinality) << 32;
+        words[2 + 2 * i] = offset | uint64_t(chunk.count) << 32;
+        // zeroes the padding of the last word
+        words[offset + data_words - 1] = 0;
+        if (chunk.kind == detail::roaring_kind::bitmap) {
+            memcpy(words + offset, chunk.words,
+                   data_words * sizeof(uint64_t));
+        } else {
+            const size_t n = chunk.kind == detail::roaring_kind::run
+                                 ? 2 * chunk.count
+                                 : chunk.count;
+            memcpy(words + offset, chunk.values, n * sizeof(uint16_t));
+        }
+        offset += data_words;
+    }
+}
+
+inline roaring_view::roaring_view(const void* data, size_t bytes)
+    : mWords((const uint64_t*)data) {
+    auto invalid = [](const char* what) {
+        throw std::runtime_error(std::string("roaring_view: ") + what);
+    };
+    const size_t words = bytes / sizeof(uint64_t);
+    if ((uintptr_t)data % alignof(uint64_t) != 0) {
+        invalid("data is not aligned to 8 bytes");
+    }
+    if (words == 0 || uint32_t(mWords[0]) != roaring_bitmap::serialized_magic) {
+        invalid("no serialized bitmap");
+    }
+    mChunks = mWords[0] >> 32;
+    if (words < 1 + 2 * mChunks) {
+        invalid("truncated chunk table");
+    }
+    for (size_t i = 0; i < mChunks; ++i) {
+        const detail::roaring_chunk_view view = chunk(i);
+        const size_t offset = uint32_t(mWords[2 + 2 * i]);
+        const bool empty = view.kind == detail::roaring_kind::bitmap
+                               ? view.cardinality == 0
+                               : view.count == 0;
+        if (view.kind > detail::roaring_kind::run || empty ||
+            (i > 0 && view.key <= chunk(i - 1).key) ||
+            offset < 1 + 2 * mChunks ||
+            offset + detail::roaring_data_words(view.kind, view.count) >
+                words) {
+            invalid("corrupt chunk table");
+        }
+    }
+}
+
+inline detail::roaring_chunk_view roaring_view::chunk(size_t i) const {
+    const uint64_t header = mWords[1 + 2 * i];
+    const uint64_t data = mWords[2 + 2 * i];
+    detail::roaring_chunk_view view;
+    view.key = uint16_t(header);
+    view.kind = detail::roaring_kind(uint8_t(header >> 16));
+    view.cardinality = uint32_t(header >> 32);
+    view.count = uint32_t(data >> 32);
+    const uint64_t* words = mWords + uint32_t(data);
+    if (view.kind == detail::roaring_kind::bitmap) {
+        view.words = words;
+    } else {
+        view.values = (const uint16_t*)words;
+    }
+    return view;
+}
+
+inline bool roaring_view::contains(uint32_t value) const {
+    const uint16_t key = value >> 16;
+    size_t first = 0, n = mChunks;
+    while (n > 0) {
+        const size_t half = n / 2;
+        if (uint16_t(mWords[1 + 2 * (first + half)]) < key) {
+            first += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return first != mChunks && uint16_t(mWords[1 + 2 * first]) == key &&
+           chunk(first).contains(uint16_t(value));
+}
+
+inline size_t roaring_view::cardinality() const noexcept {
+    size_t n = 0;
+    for (size_t i = 0; i < mChunks; ++i) {
+        n += mWords[1 + 2 * i] >> 32;
+    }
+    return n;
+}
+
+}  // namespace cpp::common::container
@@ -0,0 +1,572 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
+#include "index_iterator.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+namespace detail {
+
+// Segments of about 16 KiB: large enough that walking one is a plain array
+// loop, small enough that the unused tail of the last one stays cheap.
+template <typename T>
+inline constexpr size_t default_segment_size =
+    sizeof(T) >= 16384 ? 1 : std::bit_floor(16384 / sizeof(T));
+
+}  // namespace detail
+
+/*
+ * A vector whose elements live in fixed-size segments of SegmentSize
+ * elements that never move. Growing allocates one more segment and only
+ * appends its address to a directory, so push_back never copies elements,
+ * costs the same on every call apart from that one allocation, and
+ * references, pointers and iterators stay valid until the element they
+ * refer to is erased. operator[] is a shift and a mask away from the
+ * element; loops that care about speed should go segment by segment with
+ * segment_count() and segment(), each of which is a contiguous span.
+ *
+ * The interface follows vector, minus data(), and with insert() and
+ * erase() in the middle shifting elements across segment boundaries.
+ * clear() and shrinking resize() keep the segments; shrink_to_fit() frees
+ * the ones that hold no element.
+ */
+template <typename T, size_t SegmentSize = detail::default_segment_size<T>,
+          typename Allocator = malloc_allocator<T>>
+class segmented_vector {
+    static_assert(std::has_single_bit(SegmentSize),
+                  "the segment size must be a power of two");
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "fancy pointers are not supported");
+    typedef typename alloc_traits::template rebind_alloc<T*>
+        directory_allocator;
+    static constexpr size_t segment_shift = std::countr_zero(SegmentSize);
+    static constexpr size_t segment_mask = SegmentSize - 1;
+
+   public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef detail::index_iterator<segmented_vector, T> iterator;
+    typedef detail::index_iterator<const segmented_vector, const T>
+        const_iterator;
+    static constexpr size_t segment_size = SegmentSize;
+
+    segmented_vector() = default;
+    explicit segmented_vector(const Allocator& alloc)
+        : mSegments(directory_allocator(alloc)), mAlloc(alloc) {}
+    explicit segmented_vector(size_t n, const Allocator& alloc = Allocator());
+    segmented_vector(size_t n, const T& val,
+                     const Allocator& alloc = Allocator());
+    template <detail::legacy_input_iterator InputIterator>
+    segmented_vector(InputIterator first, InputIterator last,
+                     const Allocator& alloc = Allocator());
+    segmented_vector(std::initializer_list<T> il,
+                     const Allocator& alloc = Allocator());
+    segmented_vector(const segmented_vector& rhs);
+    segmented_vector(segmented_vector&& rhs) noexcept;
+    ~segmented_vector();
+
+    segmented_vector& operator=(const segmented_vector& rhs);
+    segmented_vector& operator=(segmented_vector&& rhs);
+    segmented_vector& operator=(std::initializer_list<T> il);
+
+    allocator_type get_allocator() const noexcept { return mAlloc; }
+
+    size_t size() const noexcept { return mSize; }
+    size_t capacity() const noexcept {
+        return mSegments.size() * SegmentSize;
+    }
+    bool empty() const noexcept { return mSize == 0; }
+    // Allocates segments until n elements fit.
+    void reserve(size_t n);
+    // Frees the segments past the one holding the last element.
+    void shrink_to_fit();
+    void resize(size_t n);
+    void resize(size_t n, const T& val);
+
+    T& operator[](size_t n) {
+        return mSegments[n >> segment_shift][n & segment_mask];
+    }
+    const T& operator[](size_t n) const {
+        return mSegments[n >> segment_shift][n & segment_mask];
+    }
+    // Throws out_of_range if n is not below size().
+    T& at(size_t n);
+    const T& at(size_t n) const;
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[mSize - 1]; }
+    const T& back() const { return (*this)[mSize - 1]; }
+
+    // The number of segments that hold elements.
+    size_t segment_count() const noexcept {
+        return (mSize + segment_mask) >> segment_shift;
+    }
+    // The elements of segment i; only the last one may be partly filled.
+    std::span<T> segment(size_t i) noexcept {
+        return {mSegments[i], segment_length(i)};
+    }
+    std::span<const T> segment(size_t i) const noexcept {
+        return {mSegments[i], segment_length(i)};
+    }
+
+    void assign(size_t n, const T& val);
+    template <detail::legacy_input_iterator InputIterator>
+    void assign(InputIterator first, InputIterator last);
+    void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+    template <detail::legacy_input_iterator InputIterator>
+    void append(InputIterator first, InputIterator last);
+    void append(std::initializer_list<T> il) { append(il.begin(), il.end()); }
+
+    void push_back(const T& val) { emplace_back(val); }
+    void push_back(T&& val) { emplace_back(std::move(val)); }
+    template <class... Args>
+    T& emplace_back(Args&&... args);
+    void pop_back();
+
+    iterator insert(const_iterator position, const T& val);
+    iterator insert(const_iterator position, T&& val);
+    iterator insert(const_iterator position, size_t n, const T& val);
+    template <detail::legacy_input_iterator InputIterator>
+    iterator insert(const_iterator position, InputIterator first,
+                    InputIterator last);
+    iterator insert(const_iterator position, std::initializer_list<T> il);
+    template <class... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    void swap(segmented_vector& rhs) noexcept;
+    // Destroys the elements and keeps the segments for reuse.
+    void clear() noexcept;
+
+    iterator begin() { return iterator(this, 0); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    iterator end() { return iterator(this, mSize); }
+    const_iterator end() const { return const_iterator(this, mSize); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+   private:
+    size_t segment_length(size_t i) const noexcept {
+        return std::min(SegmentSize, mSize - (i << segment_shift));
+    }
+    void add_segment();
+    void truncate(size_t n) noexcept;
+    // Moves the elements appended from index `first` on to `position`.
+    iterator rotate_into_place(size_t position, size_t first);
+    void release() noexcept;
+
+    vector<T*, directory_allocator> mSegments;
+    size_t mSize = 0;
+    [[no_unique_address]] Allocator mAlloc;
+};
+
+/*
+ * Both sides split their elements at the same indices, so equal sizes are
+ * compared one segment at a time with the same memcmp/SIMD kernels as
+ * vector.
+ */
+template <typename T, size_t SegmentSize, typename Allocator>
+bool operator==(const segmented_vector<T, SegmentSize, Allocator>& lhs,
+                const segmented_vector<T, SegmentSize, Allocator>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.segment_count(); ++i) {
+        auto segment = lhs.segment(i);
+        if (!detail::equal(segment.data(), rhs.segment(i).data(),
+                           segment.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+auto operator<=>(const segmented_vector<T, SegmentSize, Allocator>& lhs,
+                 const segmented_vector<T, SegmentSize, Allocator>& rhs) {
+    typedef decltype(detail::synth_three_way()(lhs[0], rhs[0])) ordering;
+    const size_t n = std::min(lhs.size(), rhs.size());
+    for (size_t first = 0; first < n; first += SegmentSize) {
+        const size_t i = first / SegmentSize;
+        const size_t length = std::min(SegmentSize, n - first);
+        const T* a = lhs.segment(i).data();
+        const T* b = rhs.segment(i).data();
+        if constexpr (is_bitwise_comparable_v<T>) {
+            const size_t index = detail::mismatch(a, b, length);
+            if (index < length) {
+                return ordering(detail::synth_three_way()(a[index], b[index]));
+            }
+        } else {
+            ordering result = std::lexicographical_compare_three_way(
+                a, a + length, b, b + length, detail::synth_three_way());
+            if (result != 0) {
+                return result;
+            }
+        }
+    }
+    return ordering(lhs.size() <=> rhs.size());
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+bool operator!=(const segmented_vector<T, SegmentSize, Allocator>& lhs,
+                const segmented_vector<T, SegmentSize, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    size_t n, const Allocator& alloc)
+    : segmented_vector(alloc) {
+    resize(n);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    size_t n, const T& val, const Allocator& alloc)
+    : segmented_vector(alloc) {
+    resize(n, val);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+template <detail::legacy_input_iterator InputIterator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    InputIterator first, InputIterator last, const Allocator& alloc)
+    : segmented_vector(alloc) {
+    append(first, last);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    std::initializer_list<T> il, const Allocator& alloc)
+    : segmented_vector(il.begin(), il.end(), alloc) {}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    const segmented_vector& rhs)
+    : segmented_vector(
+          alloc_traits::select_on_container_copy_construction(rhs.mAlloc)) {
+    append(rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::segmented_vector(
+    segmented_vector&& rhs) noexcept
+    : mSegments(std::move(rhs.mSegments)),
+      mSize(std::exchange(rhs.mSize, 0)),
+      mAlloc(std::move(rhs.mAlloc)) {}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>::~segmented_vector() {
+    release();
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>&
+segmented_vector<T, SegmentSize, Allocator>::operator=(
+    const segmented_vector& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+        if (mAlloc != rhs.mAlloc) {
+            release();
+        }
+        mAlloc = rhs.mAlloc;
+    }
+    assign(rhs.begin(), rhs.end());
+    return *this;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>&
+segmented_vector<T, SegmentSize, Allocator>::operator=(
+    segmented_vector&& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    constexpr bool propagate =
+        alloc_traits::propagate_on_container_move_assignment::value;
+    if (propagate || mAlloc == rhs.mAlloc) {
+        release();
+        if constexpr (propagate) {
+            mAlloc = std::move(rhs.mAlloc);
+        }
+        mSegments = std::move(rhs.mSegments);
+        mSize = std::exchange(rhs.mSize, 0);
+    } else {
+        // the segments belong to rhs' allocator; move element by element
+        assign(std::make_move_iterator(rhs.begin()),
+               std::make_move_iterator(rhs.end()));
+    }
+    return *this;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+segmented_vector<T, SegmentSize, Allocator>&
+segmented_vector<T, SegmentSize, Allocator>::operator=(
+    std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+    return *this;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::release() noexcept {
+    truncate(0);
+    for (T* segment : mSegments) {
+        alloc_traits::deallocate(mAlloc, segment, SegmentSize);
+    }
+    mSegments.clear();
+    mSegments.shrink_to_fit();
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::add_segment() {
+    T* segment = alloc_traits::allocate(mAlloc, SegmentSize);
+    try {
+        mSegments.push_back(segment);
+    } catch (...) {
+        alloc_traits::deallocate(mAlloc, segment, SegmentSize);
+        throw;
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::truncate(size_t n) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = n; i < mSize; ++i) {
+            (*this)[i].~T();
+        }
+    }
+    mSize = n;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::reserve(size_t n) {
+    while (capacity() < n) {
+        add_segment();
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::shrink_to_fit() {
+    const size_t used = segment_count();
+    for (size_t i = used; i < mSegments.size(); ++i) {
+        alloc_traits::deallocate(mAlloc, mSegments[i], SegmentSize);
+    }
+    mSegments.resize(used);
+    mSegments.shrink_to_fit();
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::resize(size_t n) {
+    if (n <= mSize) {
+        truncate(n);
+        return;
+    }
+    reserve(n);
+    while (mSize < n) {
+        emplace_back();
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::resize(size_t n,
+                                                         const T& val) {
+    if (n <= mSize) {
+        truncate(n);
+        return;
+    }
+    // val may be an element of this vector; segments never move, so it
+    // stays valid while the new ones are allocated
+    reserve(n);
+    while (mSize < n) {
+        emplace_back(val);
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+T& segmented_vector<T, SegmentSize, Allocator>::at(size_t n) {
+    if (n >= mSize) {
+        throw std::out_of_range(".at(): Invalid index!");
+    }
+    return (*this)[n];
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+const T& segmented_vector<T, SegmentSize, Allocator>::at(size_t n) const {
+    if (n >= mSize) {
+        throw std::out_of_range(".at(): Invalid index!");
+    }
+    return (*this)[n];
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::assign(size_t n,
+                                                         const T& val) {
+    const size_t common = std::min(n, mSize);
+    for (size_t i = 0; i < common; ++i) {
+        (*this)[i] = val;
+    }
+    resize(n, val);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+template <detail::legacy_input_iterator InputIterator>
+void segmented_vector<T, SegmentSize, Allocator>::assign(InputIterator first,
+                                                         InputIterator last) {
+    size_t i = 0;
+    for (; i < mSize && first != last; ++i, ++first) {
+        (*this)[i] = *first;
+    }
+    if (first == last) {
+        truncate(i);
+    } else {
+        append(first, last);
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+template <detail::legacy_input_iterator InputIterator>
+void segmented_vector<T, SegmentSize, Allocator>::append(InputIterator first,
+                                                         InputIterator last) {
+    if constexpr (detail::legacy_forward_iterator<InputIterator>) {
+        reserve(mSize + std::distance(first, last));
+    }
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+template <typename... Args>
+T& segmented_vector<T, SegmentSize, Allocator>::emplace_back(Args&&... args) {
+    if (mSize == capacity()) {
+        add_segment();
+    }
+    T* slot = &(*this)[mSize];
+    new (slot) T(std::forward<Args>(args)...);
+    ++mSize;
+    return *slot;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::pop_back() {
+    truncate(mSize - 1);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::rotate_into_place(
+    size_t position, size_t first) {
+    std::rotate(begin() + position, begin() + first, end());
+    return begin() + position;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::insert(const_iterator position,
+                                                    const T& val) {
+    return emplace(position, val);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::insert(const_iterator position,
+                                                    T&& val) {
+    return emplace(position, std::move(val));
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::insert(const_iterator position,
+                                                    size_t n, const T& val) {
+    const size_t index = position.index();
+    const size_t first = mSize;
+    resize(mSize + n, val);
+    return rotate_into_place(index, first);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+template <detail::legacy_input_iterator InputIterator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::insert(const_iterator position,
+                                                    InputIterator first,
+                                                    InputIterator last) {
+    const size_t index = position.index();
+    const size_t appended = mSize;
+    append(first, last);
+    return rotate_into_place(index, appended);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::insert(
+    const_iterator position, std::initializer_list<T> il) {
+    return insert(position, il.begin(), il.end());
+}
+
+/*
+ * The new element is built at the end, where building it cannot disturb
+ * an argument that refers into this vector, and rotated into place.
+ */
+template <typename T, size_t SegmentSize, typename Allocator>
+template <typename... Args>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::emplace(const_iterator position,
+                                                     Args&&... args) {
+    const size_t index = position.index();
+    emplace_back(std::forward<Args>(args)...);
+    return rotate_into_place(index, mSize - 1);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::erase(const_iterator position) {
+    return erase(position, position + 1);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+typename segmented_vector<T, SegmentSize, Allocator>::iterator
+segmented_vector<T, SegmentSize, Allocator>::erase(const_iterator first,
+                                                   const_iterator last) {
+    const size_t index = first.index();
+    const size_t n = last.index() - index;
+    if (n) {
+        std::move(begin() + index + n, end(), begin() + index);
+        truncate(mSize - n);
+    }
+    return begin() + index;
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::swap(
+    segmented_vector& rhs) noexcept {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        std::swap(mAlloc, rhs.mAlloc);
+    }
+    mSegments.swap(rhs.mSegments);
+    std::swap(mSize, rhs.mSize);
+}
+
+template <typename T, size_t SegmentSize, typename Allocator>
+void segmented_vector<T, SegmentSize, Allocator>::clear() noexcept {
+    truncate(0);
+}
+
+}  // namespace cpp::common::container
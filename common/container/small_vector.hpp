@@ -0,0 +1,18 @@
+#pragma once
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+/*
+ * A vector that keeps up to N elements inside the object and only asks the
+ * allocator for memory once it grows beyond that. It is the same class
+ * template as vector, so the interface and the iterators are those of
+ * vector; capacity() never drops below N.
+ * Unlike vector, moving or swapping a small_vector whose elements are
+ * inline moves the elements one by one and invalidates their iterators.
+ */
+template <typename T, size_t N, typename Allocator = malloc_allocator<T>,
+          typename GrowthPolicy = power_of_two_growth>
+using small_vector = vector<T, Allocator, GrowthPolicy, N>;
+
+}  // namespace cpp::common::container
@@ -0,0 +1,230 @@
+#pragma once
+#include <stddef.h>
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../reflection/reflection.hpp"
+#include "allocator.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+namespace detail {
+
+template <typename T>
+inline constexpr auto& soa_properties = reflection::ObjectDef<T>::Properties;
+
+template <typename T, size_t I>
+using soa_field_t = typename std::remove_cvref_t<
+    decltype(soa_properties<T>.template GetElem<I>())>::value_type;
+
+template <typename T, typename Name>
+inline constexpr size_t soa_index =
+    soa_properties<T>.template GetElemIndex<Name>();
+
+template <typename T, typename Allocator, typename Indices>
+struct soa_columns;
+
+template <typename T, typename Allocator, size_t... I>
+struct soa_columns<T, Allocator, std::index_sequence<I...>> {
+    typedef std::tuple<vector<
+        soa_field_t<T, I>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<
+            soa_field_t<T, I>>>...>
+        type;
+};
+
+}  // namespace detail
+
+/*
+ * A sequence of T stored as a struct of arrays: every property that
+ * reflection::ObjectDef<T> lists lives in a column of its own, a
+ * vector<Field> rebound from Allocator. A scan over one field then reads
+ * that column and nothing else, with the elements packed for SIMD:
+ *
+ *     double total = 0;
+ *     for (double price : orders.column<ObjectDef<Order>::price>()) {
+ *         total += price;
+ *     }
+ *
+ * Rows are reached through the proxies returned by operator[], which offer
+ * the GetProperty/SetProperty interface of reflection::Object, assignment
+ * from T and conversion back to T. Fields that ObjectDef<T> does not list
+ * are not stored; T must be default constructible to be read back whole.
+ * Any growth invalidates spans and element references, as with vector.
+ */
+template <typename T, typename Allocator = malloc_allocator<T>>
+class soa_vector {
+    static constexpr size_t field_count = detail::soa_properties<T>.size;
+    typedef std::make_index_sequence<field_count> fields;
+
+    template <typename Name>
+    static constexpr size_t index_of() {
+        constexpr size_t index = detail::soa_index<T, Name>;
+        static_assert(index != size_t(-1), "not a property of T");
+        return index;
+    }
+    template <size_t I>
+    static constexpr auto member() {
+        return detail::soa_properties<T>.template GetElem<I>().value;
+    }
+
+   public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    template <typename Name>
+    using field_type = detail::soa_field_t<T, index_of<Name>()>;
+
+    template <bool Const>
+    class row_reference;
+    typedef row_reference<false> reference;
+    typedef row_reference<true> const_reference;
+
+    soa_vector() = default;
+    explicit soa_vector(const Allocator& alloc)
+        : mColumns(make_columns(alloc, fields())) {}
+
+    size_t size() const noexcept { return std::get<0>(mColumns).size(); }
+    bool empty() const noexcept { return size() == 0; }
+    void reserve(size_t n) {
+        for_each_column([n](auto& column) { column.reserve(n); });
+    }
+    // New rows are value-initialized field by field.
+    void resize(size_t n) {
+        // allocation failures strike before any column changes length
+        reserve(n);
+        for_each_column([n](auto& column) { column.resize(n); });
+    }
+    void shrink_to_fit() {
+        for_each_column([](auto& column) { column.shrink_to_fit(); });
+    }
+    void clear() noexcept {
+        for_each_column([](auto& column) { column.clear(); });
+    }
+
+    void push_back(const T& row) { push_back_fields(row, fields()); }
+    void push_back(T&& row) { push_back_fields(std::move(row), fields()); }
+    void pop_back() {
+        for_each_column([](auto& column) { column.pop_back(); });
+    }
+
+    reference operator[](size_t n) { return reference(this, n); }
+    const_reference operator[](size_t n) const {
+        return const_reference(this, n);
+    }
+    // Throws out_of_range if n is not below size().
+    reference at(size_t n) {
+        check_index(n);
+        return (*this)[n];
+    }
+    const_reference at(size_t n) const {
+        check_index(n);
+        return (*this)[n];
+    }
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    // The contiguous values of property Name, one per row.
+    template <typename Name>
+    std::span<field_type<Name>> column() noexcept {
+        auto& column = std::get<index_of<Name>()>(mColumns);
+        return {column.data(), column.size()};
+    }
+    template <typename Name>
+    std::span<const field_type<Name>> column() const noexcept {
+        auto& column = std::get<index_of<Name>()>(mColumns);
+        return {column.data(), column.size()};
+    }
+
+    template <bool Const>
+    class row_reference {
+        typedef std::conditional_t<Const, const soa_vector, soa_vector>
+            container_type;
+
+       public:
+        row_reference(container_type* container, size_t index)
+            : mContainer(container), mIndex(index) {}
+
+        template <typename Name>
+        decltype(auto) GetProperty() const {
+            return std::get<index_of<Name>()>(mContainer->mColumns)[mIndex];
+        }
+        template <typename Name, typename V>
+        void SetProperty(V&& value) const
+            requires(!Const) {
+            GetProperty<Name>() = std::forward<V>(value);
+        }
+        const row_reference& operator=(const T& row) const
+            requires(!Const) {
+            store(row, fields());
+            return *this;
+        }
+        explicit operator T() const { return load(fields()); }
+
+       private:
+        template <size_t... I>
+        void store(const T& row, std::index_sequence<I...>) const {
+            ((std::get<I>(mContainer->mColumns)[mIndex] = row.*member<I>()),
+             ...);
+        }
+        template <size_t... I>
+        T load(std::index_sequence<I...>) const {
+            T row{};
+            ((row.*member<I>() = std::get<I>(mContainer->mColumns)[mIndex]),
+             ...);
+            return row;
+        }
+
+        container_type* mContainer;
+        size_t mIndex;
+    };
+
+   private:
+    typedef typename detail::soa_columns<T, Allocator, fields>::type columns;
+
+    template <size_t... I>
+    static columns make_columns(const Allocator& alloc,
+                                std::index_sequence<I...>) {
+        return columns(std::tuple_element_t<I, columns>(
+            typename std::tuple_element_t<I, columns>::allocator_type(
+                alloc))...);
+    }
+    template <typename Function>
+    void for_each_column(Function&& f) {
+        std::apply([&](auto&... column) { (f(column), ...); }, mColumns);
+    }
+    void check_index(size_t n) const {
+        if (n >= size()) {
+            throw std::out_of_range(".at(): Invalid index!");
+        }
+    }
+    /*
+     * Appends one field per column. If a column throws, the columns that
+     * already took their field drop it again, keeping all of them the same
+     * length.
+     */
+    template <typename Row, size_t... I>
+    void push_back_fields(Row&& row, std::index_sequence<I...>) {
+        size_t pushed = 0;
+        try {
+            ((std::get<I>(mColumns).push_back(
+                  std::forward<Row>(row).*member<I>()),
+              ++pushed),
+             ...);
+        } catch (...) {
+            ((I < pushed ? std::get<I>(mColumns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    columns mColumns;
+};
+
+}  // namespace cpp::common::container
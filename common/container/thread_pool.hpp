@@ -0,0 +1,139 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cpp::common::container {
+
+/*
+ * A fixed set of worker threads for the data-parallel paths of the
+ * containers, e.g. vector's parallel_t overloads. parallel_for() is the
+ * only way to hand out work; the calling thread takes part in it, so a
+ * pool of concurrency() n has n - 1 workers.
+ *
+ * parallel_for() must not be called from inside a parallel_for() of the
+ * same pool.
+ */
+class thread_pool {
+   public:
+    explicit thread_pool(
+        size_t concurrency = std::thread::hardware_concurrency()) {
+        for (size_t i = 1; i < concurrency; ++i) {
+            mWorkers.emplace_back([this] { run(); });
+        }
+    }
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWake.notify_all();
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    // The pool the containers use unless told otherwise, with one thread
+    // per hardware thread.
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    size_t concurrency() const noexcept { return mWorkers.size() + 1; }
+
+    /*
+     * Calls f(i) for every i in [0, n) and returns once all calls have
+     * finished. Indices are handed out one at a time to whichever thread
+     * is free. If calls throw, the remaining ones still run and the first
+     * exception is rethrown afterwards.
+     */
+    template <typename Function>
+    void parallel_for(size_t n, Function&& f);
+
+   private:
+    void run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWake.wait(lock, [this] { return mStop || !mTasks.empty(); });
+                if (mTasks.empty()) {
+                    return;
+                }
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<std::function<void()>> mTasks;
+    bool mStop = false;
+    std::vector<std::thread> mWorkers;
+};
+
+template <typename Function>
+void thread_pool::parallel_for(size_t n, Function&& f) {
+    const size_t helpers = std::min(n, concurrency()) - (n != 0);
+    if (helpers == 0) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next = 0;
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto drain = [&] {
+        for (size_t i; (i = next.fetch_add(1)) < n;) {
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+    std::latch finished(helpers);
+    size_t queued = 0;
+    try {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (; queued < helpers; ++queued) {
+            mTasks.emplace_back([&] {
+                drain();
+                finished.count_down();
+            });
+        }
+    } catch (...) {
+        // the queued tasks refer to this frame; finish before unwinding
+        finished.count_down(helpers - queued);
+        mWake.notify_all();
+        drain();
+        finished.wait();
+        throw;
+    }
+    mWake.notify_all();
+    drain();
+    finished.wait();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace cpp::common::container
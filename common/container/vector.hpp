@@ -1,26 +1,345 @@
 #pragma once
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "allocator.hpp"
+#include "growth_policy.hpp"
+#include "instrumentation.hpp"
+#include "pointer_iterator.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace cpp::common::container {
 
+/*
+ * Customization point: specialize to std::true_type for types whose objects
+ * can be moved to another address with memcpy, after which the source
+ * memory is released without running the destructor.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+/*
+ * Customization point: specialize to std::true_type for types whose
+ * operator== is equivalent to comparing their bytes, e.g. structs of
+ * integers without padding and with a defaulted operator==. Vectors of
+ * them are compared with memcmp, and ordering only looks at the first
+ * element found to differ by a SIMD scan. Floating point types do not
+ * qualify because of -0.0 and NaN.
+ */
+template <typename T>
+struct is_bitwise_comparable
+    : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> ||
+                         std::is_pointer_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v =
+    is_bitwise_comparable<T>::value;
+
+/*
+ * Tag asking for default- instead of value-initialization of new elements.
+ * Trivial types such as char are then left uninitialized, which spares a
+ * zeroing pass over buffers that are about to be overwritten anyway.
+ */
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+inline constexpr default_init_t default_init{};
+
+// Tag for the parallel overloads, defined in vector_parallel.hpp.
+struct parallel_t;
+
+namespace detail {
+
+template <typename It>
+concept legacy_input_iterator = std::derived_from<
+    typename std::iterator_traits<It>::iterator_category,
+    std::input_iterator_tag>;
+
+template <typename It>
+concept legacy_forward_iterator =
+    legacy_input_iterator<It> &&
+    std::derived_from<typename std::iterator_traits<It>::iterator_category,
+                      std::forward_iterator_tag>;
+
+template <typename T>
+void destroy(T* first, size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = 0; i < n; ++i) {
+            first[i].~T();
+        }
+    }
+}
+
+/*
+ * Move-constructs n objects from src into the uninitialized storage at dst
+ * if T's move constructor is noexcept (or if T cannot be copied at all),
+ * and copy-constructs them if it is not, so src stays intact whenever this
+ * throws.
+ */
+template <typename T>
+void uninitialized_move_if_noexcept(T* dst, T* src, size_t n) {
+    size_t index = 0;
+    try {
+        for (; index < n; ++index) {
+            new (dst + index) T(std::move_if_noexcept(src[index]));
+        }
+    } catch (...) {
+        destroy(dst, index);
+        throw;
+    }
+}
+
+/*
+ * memcpy of n objects of T. No array is larger than PTRDIFF_MAX bytes,
+ * which GCC cannot prove for n * sizeof(T) and warns about otherwise.
+ */
+template <typename T>
+void copy_objects(T* dst, const T* src, size_t n) {
+    if (n > PTRDIFF_MAX / sizeof(T)) {
+        __builtin_unreachable();
+    }
+    if (n) memcpy((void*)dst, (const void*)src, n * sizeof(T));
+}
+
+/*
+ * Moves n objects from src into the uninitialized storage at dst and ends
+ * the lifetime of the source objects.
+ * Trivially relocatable types are moved with a single memcpy, everything
+ * else goes through uninitialized_move_if_noexcept.
+ */
+template <typename T>
+void relocate(T* dst, T* src, size_t n) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        copy_objects(dst, src, n);
+    } else {
+        uninitialized_move_if_noexcept(dst, src, n);
+        destroy(src, n);
+    }
+}
+
+// Offset of the first byte in which lhs and rhs differ, or n.
+inline size_t mismatch_bytes(const void* lhs, const void* rhs, size_t n) {
+    auto* a = (const unsigned char*)lhs;
+    auto* b = (const unsigned char*)rhs;
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        unsigned differ = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffff;
+        if (differ) {
+            return i + std::countr_zero(differ);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Index of the first element at which lhs and rhs differ, or n.
+template <typename T>
+size_t mismatch(const T* lhs, const T* rhs, size_t n) {
+    if constexpr (is_bitwise_comparable_v<T>) {
+        return mismatch_bytes(lhs, rhs, n * sizeof(T)) / sizeof(T);
+    } else {
+        return std::mismatch(lhs, lhs + n, rhs).first - lhs;
+    }
+}
+
+#if defined(__SSE2__)
+// Packed IEEE comparison, so -0.0 == 0.0 and NaN != NaN as with operator==.
+inline bool equal_packed(const double* lhs, const double* rhs, size_t& i,
+                         size_t n) {
+    for (; i + 4 <= n; i += 4) {
+        __m128d low =
+            _mm_cmpeq_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i));
+        __m128d high =
+            _mm_cmpeq_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2));
+        if (_mm_movemask_pd(_mm_and_pd(low, high)) != 0x3) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool equal_packed(const float* lhs, const float* rhs, size_t& i,
+                         size_t n) {
+    for (; i + 8 <= n; i += 8) {
+        __m128 low = _mm_cmpeq_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i));
+        __m128 high =
+            _mm_cmpeq_ps(_mm_loadu_ps(lhs + i + 4), _mm_loadu_ps(rhs + i + 4));
+        if (_mm_movemask_ps(_mm_and_ps(low, high)) != 0xf) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 template <typename T>
+bool equal(const T* lhs, const T* rhs, size_t n) {
+    if constexpr (is_bitwise_comparable_v<T>) {
+        return !n || memcmp(lhs, rhs, n * sizeof(T)) == 0;
+    } else {
+        size_t i = 0;
+#if defined(__SSE2__)
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+            if (!equal_packed(lhs, rhs, i, n)) {
+                return false;
+            }
+        }
+#endif
+        return std::equal(lhs + i, lhs + n, rhs + i);
+    }
+}
+
+// The comparison std::lexicographical_compare_three_way falls back to for
+// types that only have operator<.
+struct synth_three_way {
+    template <typename T>
+    constexpr auto operator()(const T& lhs, const T& rhs) const {
+        if constexpr (std::three_way_comparable<T>) {
+            return lhs <=> rhs;
+        } else {
+            if (lhs < rhs) return std::weak_ordering::less;
+            if (rhs < lhs) return std::weak_ordering::greater;
+            return std::weak_ordering::equivalent;
+        }
+    }
+};
+
+/*
+ * std::uninitialized_copy that also takes the memcpy route for contiguous
+ * iterators other than raw pointers, e.g. those of std::vector or
+ * std::string, when T is trivially copyable.
+ */
+template <typename T, typename ForwardIterator>
+void copy_construct_range(ForwardIterator first, ForwardIterator last,
+                          T* dst) {
+    if constexpr (std::contiguous_iterator<ForwardIterator> &&
+                  std::is_same_v<std::iter_value_t<ForwardIterator>, T> &&
+                  std::is_trivially_copyable_v<T>) {
+        copy_objects(dst, std::to_address(first), last - first);
+    } else {
+        std::uninitialized_copy(first, last, dst);
+    }
+}
+
+// std::copy to constructed elements. Contiguous iterators, e.g. those of
+// vector, are unwrapped to pointers, for which std::copy takes memmove.
+template <typename T, typename InputIterator>
+T* copy_range(InputIterator first, InputIterator last, T* dst) {
+    if constexpr (std::contiguous_iterator<InputIterator>) {
+        const auto* src = std::to_address(first);
+        return std::copy(src, src + (last - first), dst);
+    } else {
+        return std::copy(first, last, dst);
+    }
+}
+
+/*
+ * Element storage inside the container object itself. Empty when N is 0 so
+ * that a plain vector pays nothing for it.
+ */
+template <typename T, size_t N>
+struct inline_buffer {
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+    T* data() const noexcept { return (T*)bytes; }
+};
+
+template <typename T>
+struct inline_buffer<T, 0> {
+    T* data() const noexcept { return nullptr; }
+};
+
+}  // namespace detail
+
+/*
+ * Allocator follows the standard allocator requirements. Only allocation
+ * goes through it; elements are constructed with placement new. Stateful
+ * allocators are honored on copy, move and swap according to
+ * std::allocator_traits' propagate_on_container_* traits.
+ * The first N elements are stored inside the object itself, see
+ * small_vector.hpp.
+ */
+template <typename T, typename Allocator = malloc_allocator<T>,
+          typename GrowthPolicy = power_of_two_growth,
+          size_t N = 0>
 class vector {
+    typedef std::allocator_traits<Allocator> alloc_traits;
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "fancy pointers are not supported");
+    // Moving out of the inline buffer moves the elements one by one.
+    static constexpr bool nothrow_steal =
+        N == 0 || is_trivially_relocatable_v<T> ||
+        std::is_nothrow_move_constructible_v<T>;
+    static constexpr bool nothrow_move_assign =
+        (alloc_traits::propagate_on_container_move_assignment::value ||
+         alloc_traits::is_always_equal::value) &&
+        nothrow_steal;
+
    public:
     typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef detail::pointer_iterator<vector, T> iterator;
+    typedef detail::pointer_iterator<vector, const T> const_iterator;
+
     vector() = default;
-    explicit vector(size_t n);
-    vector(size_t n, const T& val);
-    vector(const vector<T>& x);
-    vector(vector<T>&&);
-    vector(std::initializer_list<T> il);
+    explicit vector(const Allocator& alloc) noexcept;
+    explicit vector(size_t n, const Allocator& alloc = Allocator());
+    vector(size_t n, const T& val, const Allocator& alloc = Allocator());
+    vector(size_t n, default_init_t, const Allocator& alloc = Allocator());
+    // Value-initialize, fill or copy the elements in parallel, see
+    // parallel_t.
+    vector(size_t n, parallel_t par, const Allocator& alloc = Allocator());
+    vector(size_t n, const T& val, parallel_t par,
+           const Allocator& alloc = Allocator());
+    vector(const vector& x);
+    vector(const vector& x, const Allocator& alloc);
+    vector(const vector& x, parallel_t par);
+    vector(vector&&) noexcept(nothrow_steal);
+    vector(vector&& x, const Allocator& alloc);
+    /*
+     * Forward iterator ranges are measured once and copied into a buffer
+     * of exactly that size, with a single memcpy when the source is
+     * contiguous and T is trivially copyable.
+     */
+    template <detail::legacy_input_iterator InputIterator>
+    vector(InputIterator first, InputIterator last,
+           const Allocator& alloc = Allocator());
+    vector(std::initializer_list<T> il, const Allocator& alloc = Allocator());
 
     ~vector();
 
     vector& operator=(const vector& x);
-    vector& operator=(vector&& x);
+    vector& operator=(vector&& x) noexcept(nothrow_move_assign);
     vector& operator=(std::initializer_list<T> il);
 
+    allocator_type get_allocator() const noexcept;
+
     // capacity
     size_t size() const noexcept;
     /*
@@ -38,6 +357,12 @@ class vector {
      */
     void resize(size_t n);
     void resize(size_t n, const T& val);
+    // Like resize(n), but new elements are default-initialized.
+    void resize(size_t n, default_init_t);
+    // Like resize(n) and resize(n, val), but new elements are built and
+    // removed ones destroyed in parallel, see parallel_t.
+    void resize(size_t n, parallel_t par);
+    void resize(size_t n, const T& val, parallel_t par);
     size_t capacity() const noexcept;
     bool empty() const noexcept;
     /*
@@ -46,6 +371,8 @@ class vector {
      * If n is greater than the current vector capacity, the function
      * causes the container to reallocate its storage increasing its
      * capacity to n (or greater).
+     * Elements are relocated into the new storage with detail::relocate,
+     * i.e. moved rather than copied whenever that cannot throw.
      */
     void reserve(size_t n);
     /*
@@ -77,182 +404,59 @@ class vector {
     T* data() noexcept;
     const T* data() const noexcept;
     void assign(size_t n, const T& val);
-    // void assign (initializer_list<value_type> il);
+    // Fills the vector with n copies of val in parallel, see parallel_t.
+    void assign(size_t n, const T& val, parallel_t par);
+    // [first, last) must not point into the vector.
+    template <detail::legacy_input_iterator InputIterator>
+    void assign(InputIterator first, InputIterator last);
+    void assign(std::initializer_list<T> il);
+    // Same as insert(end(), ...): a forward range grows the buffer at most
+    // once.
+    template <detail::legacy_input_iterator InputIterator>
+    void append(InputIterator first, InputIterator last);
+    void append(std::initializer_list<T> il);
 
     void push_back(const T& val);
     void push_back(T&& val);
     void pop_back();
 
-    // iterator insert (const_iterator position, const value_type& val);
-    // iterator insert (const_iterator position, size_type n, const value_type&
-    // val); template <class InputIterator> iterator insert (const_iterator
-    // position, InputIterator first, InputIterator last); iterator insert
-    // (const_iterator position, value_type&& val); iterator insert
-    // (const_iterator position, initializer_list<value_type> il); iterator
-    // erase (const_iterator position); iterator erase (const_iterator first,
-    // const_iterator last);
+    /*
+     * Two-phase append for writers that produce elements in place, e.g.
+     * read() into a vector<char>. prepare_append(n) makes room for n more
+     * elements and returns the start of the uninitialized tail;
+     * commit_append(n) then adds the first n elements of that tail to the
+     * vector. Objects of non-trivial types have to be constructed in the
+     * tail before they are committed. Anything but a commit in between
+     * invalidates the pointer.
+     * commit_append() throws out_of_range if n exceeds the spare capacity.
+     */
+    T* prepare_append(size_t n);
+    void commit_append(size_t n);
+
+    /*
+     * The insert family constructs the new elements directly in their final
+     * place. A range of known length reserves storage once; when a
+     * reallocation is needed the new elements are built first so that
+     * arguments referring into the vector stay valid. Trivially relocatable
+     * elements after position are shifted with a single memmove.
+     */
+    iterator insert(const_iterator position, const T& val);
+    iterator insert(const_iterator position, size_t n, const T& val);
+    template <detail::legacy_input_iterator InputIterator>
+    iterator insert(const_iterator position, InputIterator first,
+                    InputIterator last);
+    iterator insert(const_iterator position, T&& val);
+    iterator insert(const_iterator position, std::initializer_list<T> il);
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
     void swap(vector& x);
     void clear() noexcept;
-    // template <class... Args>
-    // iterator emplace (const_iterator position, Args&&... args);
-    // template <class... Args>
-    //   void emplace_back (Args&&... args);
-    class iterator : public std::iterator<std::random_access_iterator_tag, T> {
-        T* mPointer;
-
-       public:
-        using it_tag = std::iterator<std::random_access_iterator_tag, T>;
-
-        explicit iterator(T* pointer) : mPointer(pointer) {}
-        iterator& operator=(const iterator& rhs) {
-            mPointer = rhs.mPointer;
-            return *this;
-        }
-        iterator& operator++() {
-            ++mPointer;
-            return *this;
-        }
-        iterator operator++(int) {
-            iterator retval = *this;
-            ++(*this);
-            return retval;
-        }
-        iterator& operator--() {
-            --mPointer;
-            return *this;
-        }
-        iterator operator--(int) {
-            iterator retval = *this;
-            --(*this);
-            return retval;
-        }
-        bool operator==(const iterator& other) const {
-            return mPointer == other.mPointer;
-        }
-        bool operator!=(const iterator& other) const {
-            return !(*this == other);
-        }
-        const typename it_tag::reference operator*() const { return *mPointer; }
-        typename it_tag::reference operator*() { return *mPointer; }
-        const typename it_tag::pointer operator->() const { return mPointer; }
-        typename it_tag::pointer operator->() { return mPointer; }
-        iterator operator+(typename it_tag::difference_type dist) {
-            return iterator(mPointer + dist);
-        }
-        iterator operator-(typename it_tag::difference_type dist) {
-            return iterator(mPointer - dist);
-        }
-        typename it_tag::difference_type operator-(const iterator& rhs) {
-            return mPointer - rhs.mPointer;
-        }
-        bool operator<(const iterator& rhs) const {
-            return mPointer < rhs.mPointer;
-        }
-        bool operator>(const iterator& rhs) const {
-            return mPointer > rhs.mPointer;
-        }
-        bool operator<=(const iterator& rhs) const {
-            return mPointer <= rhs.mPointer;
-        }
-        bool operator>=(const iterator& rhs) const {
-            return mPointer >= rhs.mPointer;
-        }
-        iterator& operator+=(typename it_tag::difference_type dist) {
-            mPointer += dist;
-            return *this;
-        }
-        iterator& operator-=(typename it_tag::difference_type dist) {
-            mPointer -= dist;
-            return *this;
-        }
-        const typename it_tag::reference operator[](
-            typename it_tag::difference_type dist) const {
-            return *(mPointer + dist);
-        }
-        typename it_tag::reference operator[](
-            typename it_tag::difference_type dist) {
-            return *(mPointer + dist);
-        }
-        void swap(iterator& rhs) { std::swap(mPointer, rhs.mPointer); }
-        friend iterator operator+(typename it_tag::difference_type dist,
-                                  const iterator& iter);
-    };
-    class const_iterator
-        : public std::iterator<std::random_access_iterator_tag, const T> {
-        const T* mPointer;
-
-       public:
-        using it_tag = std::iterator<std::random_access_iterator_tag, const T>;
-
-        explicit const_iterator(T* pointer) : mPointer(pointer) {}
-        const_iterator& operator=(const const_iterator& rhs) {
-            mPointer = rhs.mPointer;
-            return *this;
-        }
-        const_iterator& operator++() {
-            ++mPointer;
-            return *this;
-        }
-        const_iterator operator++(int) {
-            const_iterator retval = *this;
-            ++(*this);
-            return retval;
-        }
-        const_iterator& operator--() {
-            --mPointer;
-            return *this;
-        }
-        const_iterator operator--(int) {
-            const_iterator retval = *this;
-            --(*this);
-            return retval;
-        }
-        bool operator==(const const_iterator& other) const {
-            return mPointer == other.mPointer;
-        }
-        bool operator!=(const const_iterator& other) const {
-            return !(*this == other);
-        }
-        typename it_tag::reference operator*() const { return *mPointer; }
-        typename it_tag::pointer operator->() const { return mPointer; }
-
-        const_iterator operator+(typename it_tag::difference_type dist) {
-            return const_iterator(mPointer + dist);
-        }
-        const_iterator operator-(typename it_tag::difference_type dist) {
-            return const_iterator(mPointer - dist);
-        }
-        typename it_tag::difference_type operator-(const const_iterator& rhs) {
-            return mPointer - rhs.mPointer;
-        }
-        bool operator<(const const_iterator& rhs) const {
-            return mPointer < rhs.mPointer;
-        }
-        bool operator>(const const_iterator& rhs) const {
-            return mPointer > rhs.mPointer;
-        }
-        bool operator<=(const const_iterator& rhs) const {
-            return mPointer <= rhs.mPointer;
-        }
-        bool operator>=(const const_iterator& rhs) const {
-            return mPointer >= rhs.mPointer;
-        }
-        const_iterator& operator+=(typename it_tag::difference_type dist) {
-            mPointer += dist;
-            return *this;
-        }
-        const_iterator& operator-=(typename it_tag::difference_type dist) {
-            mPointer -= dist;
-            return *this;
-        }
-        typename it_tag::reference operator[](
-            typename it_tag::difference_type dist) {
-            return *(mPointer + dist);
-        }
-        void swap(const_iterator& rhs) { std::swap(mPointer, rhs.mPointer); }
-        friend const_iterator operator+(typename it_tag::difference_type dist,
-                                        const const_iterator& iter);
-    };
+    // Destroys the elements in parallel, see parallel_t.
+    void clear(parallel_t par);
+    template <class... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+    template <class... Args>
+    T& emplace_back(Args&&... args);
 
     iterator begin() { return iterator(mvector_data.begin); }
     const_iterator begin() const { return const_iterator(mvector_data.begin); }
@@ -260,310 +464,902 @@ class vector {
     const_iterator end() const {
         return const_iterator(mvector_data.begin + mvector_data.used);
     }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
 
    private:
+    template <typename ForwardIterator>
+    void insert_in_place(size_t index, size_t n, ForwardIterator first,
+                         ForwardIterator last);
+    void insert_in_place(size_t index, size_t n, const T& val);
+    void insert_in_place(size_t index, T&& val);
+    // Destroys the elements and gives the buffer back to the allocator.
+    void release() noexcept;
+    void copy_into_empty(const vector& rhs);
+    // Builds the elements [used, n) with construct(first, count) in
+    // parallel.
+    template <typename Construct>
+    void parallel_grow(size_t n, parallel_t par, Construct&& construct);
+    void move_into_empty(vector& rhs);
+    size_t grown_storage(size_t required) const {
+        return GrowthPolicy::capacity(mvector_data.storage, required,
+                                      sizeof(T));
+    }
+    bool holds(const T* pointer) const {
+        return std::less_equal<const T*>()(mvector_data.begin, pointer) &&
+               std::less<const T*>()(pointer,
+                                     mvector_data.begin + mvector_data.used);
+    }
+
+    /*
+     * An empty vector_data points at its inline buffer (nullptr when there
+     * is none) with a storage of N; only requests beyond that
+     * reach the allocator.
+     */
     struct vector_data {
-        T* begin = nullptr;
-        size_t used = 0;
-        size_t storage = 0;
-        vector_data() {}
-        ~vector_data() {
-            for (size_t i = 0; i < used; ++i) {
-                begin[i].~T();
+        T* begin;
+        size_t used;
+        size_t storage;
+        [[no_unique_address]] Allocator alloc;
+        [[no_unique_address]] detail::inline_buffer<T, N> buffer;
+        vector_data() { reset(); }
+        explicit vector_data(const Allocator& a) : alloc(a) { reset(); }
+        ~vector_data() { destroy_memory(); }
+        bool is_inline() const { return N && begin == buffer.data(); }
+        void reset() {
+            begin = buffer.data();
+            used = 0;
+            storage = N;
+        }
+        T* allocate(size_t n) {
+            if (n <= N) {
+                return buffer.data();
+            }
+            T* pointer = alloc_traits::allocate(alloc, n);
+            detail::on_allocate<vector>(n * sizeof(T));
+            return pointer;
+        }
+        void deallocate(T* pointer, size_t n) {
+            if (pointer && pointer != buffer.data()) {
+                alloc_traits::deallocate(alloc, pointer, n);
+            }
+        }
+        void deallocate() { deallocate(begin, storage); }
+        // Reports the heap buffer as retired, before it is freed or
+        // replaced by a larger or smaller one.
+        void retire() const {
+            if (begin && !is_inline()) {
+                detail::on_retire<vector>(used, (storage - used) * sizeof(T));
             }
-            if (begin) free(begin);
         }
         void destroy_memory() {
-            for (size_t i = 0; i < used; ++i) {
-                begin[i].~T();
+            retire();
+            detail::destroy(begin, used);
+            deallocate();
+        }
+        // Gives an empty vector_data room for at least n elements.
+        void acquire(size_t n) {
+            begin = allocate(n);
+            storage = std::max(n, N);
+        }
+        // Takes over the buffer of rhs, leaving rhs empty. This side must be
+        // empty and must not own a heap buffer. Elements in the inline
+        // buffer of rhs are relocated into ours.
+        void steal(vector_data& rhs) noexcept(nothrow_steal) {
+            if (rhs.is_inline()) {
+                detail::relocate(begin, rhs.begin, rhs.used);
+                used = rhs.used;
+                rhs.used = 0;
+                return;
             }
-            free(begin);
+            begin = rhs.begin;
+            used = rhs.used;
+            storage = rhs.storage;
+            rhs.reset();
+        }
+        /*
+         * Replaces the buffer with new_storage elements worth of memory and
+         * relocates the live elements into it, leaving n uninitialized
+         * elements at index for construct(gap) to fill. construct runs
+         * before anything is relocated, so its arguments may still refer
+         * into the old buffer; it must clean up after itself if it throws.
+         */
+        template <typename Construct>
+        void reallocate(size_t new_storage, size_t index, size_t n,
+                        Construct&& construct) {
+            if constexpr (is_trivially_relocatable_v<T> &&
+                          reallocating_allocator<Allocator, T>) {
+                if (index == used && n <= 1 && !is_inline() &&
+                    new_storage > N) {
+                    reallocate_in_place(new_storage, n, construct);
+                    return;
+                }
+            }
+            T* temp = allocate(new_storage);
+            try {
+                construct(temp + index);
+            } catch (...) {
+                deallocate(temp, new_storage);
+                throw;
+            }
+            if constexpr (is_trivially_relocatable_v<T>) {
+                detail::relocate(temp, begin, index);
+                detail::relocate(temp + index + n, begin + index,
+                                 used - index);
+            } else {
+                try {
+                    detail::uninitialized_move_if_noexcept(temp, begin, index);
+                    try {
+                        detail::uninitialized_move_if_noexcept(
+                            temp + index + n, begin + index, used - index);
+                    } catch (...) {
+                        detail::destroy(temp, index);
+                        throw;
+                    }
+                } catch (...) {
+                    detail::destroy(temp + index, n);
+                    deallocate(temp, new_storage);
+                    throw;
+                }
+                detail::destroy(begin, used);
+            }
+            if (begin) {
+                detail::on_reallocate<vector>(used * sizeof(T));
+            }
+            retire();
+            deallocate();
+            begin = temp;
+            used += n;
+            storage = new_storage;
+        }
+        void reallocate(size_t new_storage) {
+            reallocate(new_storage, used, 0, [](T*) {});
+        }
+        // Growth at the end through the allocator's reallocate, which may
+        // extend the block without copying. The new element is built aside
+        // first because its arguments may refer into the current block.
+        template <typename Construct>
+        void reallocate_in_place(size_t new_storage, size_t n,
+                                 Construct& construct) {
+            alignas(T) unsigned char element[sizeof(T)];
+            if (n) {
+                construct((T*)element);
+            }
+            const auto old_begin = (uintptr_t)begin;
+            try {
+                begin = alloc.reallocate(begin, storage, new_storage);
+            } catch (...) {
+                if (n) detail::destroy((T*)element, 1);
+                throw;
+            }
+            detail::on_allocate<vector>(new_storage * sizeof(T));
+            if (old_begin) {
+                detail::on_reallocate<vector>(
+                    (uintptr_t)begin != old_begin ? used * sizeof(T) : 0);
+                detail::on_retire<vector>(used, (storage - used) * sizeof(T));
+            }
+            if (n) {
+                memcpy(begin + used, element, sizeof(T));
+            }
+            used += n;
+            storage = new_storage;
+        }
+        // Shifts the trivially relocatable elements from index on n places
+        // to the right, leaving a gap of uninitialized memory.
+        void open_gap(size_t index, size_t n) {
+            memmove(begin + index + n, begin + index,
+                    (used - index) * sizeof(T));
+            used += n;
+        }
+        void close_gap(size_t index, size_t n) {
+            memmove(begin + index, begin + index + n,
+                    (used - index - n) * sizeof(T));
+            used -= n;
         }
     };
     vector_data mvector_data;
 };
 
-static size_t calculate_storage(size_t size) {
-    /*
-     * if on x86
-     * asm(bsr)
-     */
-    size_t storage = 1;
-    while (storage < size) {
-        storage = storage << 1;
-    }
-    return storage;
+/*
+ * Bitwise comparable elements (see is_bitwise_comparable) are compared with
+ * memcmp for equality and with a SIMD scan for the first difference when
+ * ordering. float and double are compared with SSE2 where available;
+ * other types go element by element.
+ */
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+bool operator==(const vector<T, Allocator, GrowthPolicy, N>& lhs,
+                const vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    return lhs.size() == rhs.size() &&
+           detail::equal(lhs.data(), rhs.data(), lhs.size());
 }
 
-template <typename T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
-    if (lhs.size() != rhs.size()) {
-        return false;
-    }
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        if (lhs[i] != rhs[i]) {
-            return false;
+// Returns the index of the first position at which lhs and rhs differ, or
+// the size of the shorter one if it is a prefix of the other.
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+size_t mismatch(const vector<T, Allocator, GrowthPolicy, N>& lhs,
+                const vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    return detail::mismatch(lhs.data(), rhs.data(),
+                            std::min(lhs.size(), rhs.size()));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+auto operator<=>(const vector<T, Allocator, GrowthPolicy, N>& lhs,
+                 const vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    typedef decltype(detail::synth_three_way()(lhs[0], rhs[0])) ordering;
+    if constexpr (is_bitwise_comparable_v<T>) {
+        const size_t index = mismatch(lhs, rhs);
+        if (index < lhs.size() && index < rhs.size()) {
+            return ordering(
+                detail::synth_three_way()(lhs[index], rhs[index]));
         }
+        return ordering(lhs.size() <=> rhs.size());
+    } else {
+        return std::lexicographical_compare_three_way(
+            lhs.data(), lhs.data() + lhs.size(), rhs.data(),
+            rhs.data() + rhs.size(), detail::synth_three_way());
     }
-    return true;
 }
 
-template <typename T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+bool operator!=(const vector<T, Allocator, GrowthPolicy, N>& lhs,
+                const vector<T, Allocator, GrowthPolicy, N>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename T>
-vector<T>::vector(size_t n) {
-    mvector_data.begin = (T*)malloc(n * sizeof(T));
-    for (size_t i = 0; i < n; ++i) {
-        new (mvector_data.begin + i) T();
-    }
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(const Allocator& alloc) noexcept
+    : mvector_data(alloc) {}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(size_t n, const Allocator& alloc)
+    : mvector_data(alloc) {
+    mvector_data.acquire(n);
+    std::uninitialized_value_construct_n(mvector_data.begin, n);
     mvector_data.used = n;
-    mvector_data.storage = n;
 }
 
-template <typename T>
-vector<T>::vector(size_t n, const T& val) {
-    mvector_data.begin = (T*)malloc(n * sizeof(T));
-    for (size_t i = 0; i < n; ++i) {
-        new (mvector_data.begin + i) T(val);
-    }
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(size_t n, const T& val,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    mvector_data.acquire(n);
+    std::uninitialized_fill_n(mvector_data.begin, n, val);
     mvector_data.used = n;
-    mvector_data.storage = n;
 }
 
-template <typename T>
-vector<T>::vector(const vector<T>& rhs) {
-    *this = rhs;
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(size_t n, default_init_t,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    mvector_data.acquire(n);
+    std::uninitialized_default_construct_n(mvector_data.begin, n);
+    mvector_data.used = n;
 }
 
-template <typename T>
-vector<T>::vector(vector<T>&& rhs) {
-    *this = std::forward<vector<T>>(rhs);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(const vector& rhs)
+    : mvector_data(alloc_traits::select_on_container_copy_construction(
+          rhs.mvector_data.alloc)) {
+    copy_into_empty(rhs);
 }
 
-template <typename T>
-vector<T>::vector(std::initializer_list<T> il) {
-    reserve(il.size());
-    for (auto& ele : il) {
-        push_back(ele);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(const vector& rhs,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    copy_into_empty(rhs);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(vector&& rhs) noexcept(
+    nothrow_steal)
+    : mvector_data(std::move(rhs.mvector_data.alloc)) {
+    mvector_data.steal(rhs.mvector_data);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(vector&& rhs,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    if (mvector_data.alloc == rhs.mvector_data.alloc) {
+        mvector_data.steal(rhs.mvector_data);
+    } else {
+        move_into_empty(rhs);
     }
 }
 
-template <typename T>
-vector<T>::~vector() {}
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <detail::legacy_input_iterator InputIterator>
+vector<T, Allocator, GrowthPolicy, N>::vector(InputIterator first,
+                                              InputIterator last,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    assign(first, last);
+}
 
-template <typename T>
-size_t vector<T>::size() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(std::initializer_list<T> il,
+                                              const Allocator& alloc)
+    : vector(il.begin(), il.end(), alloc) {}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::~vector() {}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+size_t vector<T, Allocator, GrowthPolicy, N>::size() const noexcept {
     return mvector_data.used;
 }
 
-template <typename T>
-vector<T>& vector<T>::operator=(const vector<T>& rhs) {
-    mvector_data.begin = (T*)malloc(rhs.mvector_data.storage * sizeof(T));
-    for (size_t index = 0; index < rhs.size(); ++index) {
-        new (mvector_data.begin + index) T(rhs[index]);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>&
+vector<T, Allocator, GrowthPolicy, N>::operator=(
+    const vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                      value) {
+        if (mvector_data.alloc != rhs.mvector_data.alloc) {
+            release();
+        }
+        mvector_data.alloc = rhs.mvector_data.alloc;
+    }
+    if (mvector_data.storage < rhs.mvector_data.used) {
+        release();
+        copy_into_empty(rhs);
+    } else {
+        clear();
+        std::uninitialized_copy_n(rhs.mvector_data.begin,
+                                  rhs.mvector_data.used, mvector_data.begin);
+        mvector_data.used = rhs.mvector_data.used;
     }
-    mvector_data.used = rhs.mvector_data.used;
-    mvector_data.storage = rhs.mvector_data.storage;
     return *this;
 }
 
-template <typename T>
-vector<T>& vector<T>::operator=(vector<T>&& rhs) {
-    mvector_data = rhs.mvector_data;
-    rhs.mvector_data.begin = nullptr;
-    rhs.mvector_data.used = 0;
-    rhs.mvector_data.storage = 0;
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>&
+vector<T, Allocator, GrowthPolicy, N>::operator=(
+    vector<T, Allocator, GrowthPolicy, N>&& rhs) noexcept(nothrow_move_assign) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::
+                      value) {
+        release();
+        mvector_data.alloc = std::move(rhs.mvector_data.alloc);
+        mvector_data.steal(rhs.mvector_data);
+    } else if (mvector_data.alloc == rhs.mvector_data.alloc) {
+        release();
+        mvector_data.steal(rhs.mvector_data);
+    } else {
+        // the buffer of rhs belongs to an allocator we cannot free with
+        release();
+        move_into_empty(rhs);
+    }
     return *this;
 }
 
-template <typename T>
-vector<T>& vector<T>::operator=(std::initializer_list<T> il) {
-    *this = vector<T>(il);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::allocator_type
+vector<T, Allocator, GrowthPolicy, N>::get_allocator() const noexcept {
+    return mvector_data.alloc;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::release() noexcept {
+    mvector_data.destroy_memory();
+    mvector_data.reset();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::copy_into_empty(
+    const vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    // a copy that fits stays inline, otherwise it keeps the capacity of rhs
+    mvector_data.acquire(rhs.mvector_data.used > N ? rhs.mvector_data.storage
+                                                   : 0);
+    std::uninitialized_copy_n(rhs.mvector_data.begin, rhs.mvector_data.used,
+                              mvector_data.begin);
+    mvector_data.used = rhs.mvector_data.used;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::move_into_empty(
+    vector<T, Allocator, GrowthPolicy, N>& rhs) {
+    mvector_data.acquire(rhs.mvector_data.used);
+    std::uninitialized_move_n(rhs.mvector_data.begin, rhs.mvector_data.used,
+                              mvector_data.begin);
+    mvector_data.used = rhs.mvector_data.used;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>&
+vector<T, Allocator, GrowthPolicy, N>::operator=(std::initializer_list<T> il) {
+    assign(il);
     return *this;
 }
 
-template <typename T>
-void vector<T>::resize(size_t n) {
-    reserve(n);
-    for (size_t index = mvector_data.used; index < n; ++index) {
-        T* ele = new (mvector_data.begin + index) T();
-    }
-    for (size_t index = n; index < mvector_data.used; ++index) {
-        T* ele = &mvector_data.begin[index];
-        mvector_data.begin[index].~T();
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::resize(size_t n) {
+    if (n > mvector_data.used) {
+        reserve(n);
+        std::uninitialized_value_construct_n(
+            mvector_data.begin + mvector_data.used, n - mvector_data.used);
+    } else {
+        detail::destroy(mvector_data.begin + n, mvector_data.used - n);
     }
     mvector_data.used = n;
 }
 
-template <typename T>
-void vector<T>::resize(size_t n, const T& val) {
-    reserve(n);
-    for (size_t index = mvector_data.used; index < n; ++index) {
-        auto* ele = new (mvector_data.begin + index) T(val);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::resize(size_t n, const T& val) {
+    if (n > mvector_data.used) {
+        if (holds(&val) && n > mvector_data.storage) {
+            T copy(val);
+            resize(n, copy);
+            return;
+        }
+        reserve(n);
+        std::uninitialized_fill_n(mvector_data.begin + mvector_data.used,
+                                  n - mvector_data.used, val);
+    } else {
+        detail::destroy(mvector_data.begin + n, mvector_data.used - n);
     }
-    for (size_t index = n; index < mvector_data.used; ++index) {
-        mvector_data.begin[index].~T();
+    mvector_data.used = n;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::resize(size_t n, default_init_t) {
+    if (n > mvector_data.used) {
+        reserve(n);
+        std::uninitialized_default_construct_n(
+            mvector_data.begin + mvector_data.used, n - mvector_data.used);
+    } else {
+        detail::destroy(mvector_data.begin + n, mvector_data.used - n);
     }
     mvector_data.used = n;
 }
 
-template <typename T>
-size_t vector<T>::capacity() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+size_t vector<T, Allocator, GrowthPolicy, N>::capacity() const noexcept {
     return mvector_data.storage;
 }
 
-template <typename T>
-bool vector<T>::empty() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+bool vector<T, Allocator, GrowthPolicy, N>::empty() const noexcept {
     return mvector_data.used == 0;
 }
 
-template <typename T>
-void vector<T>::reserve(size_t n) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::reserve(size_t n) {
     if (mvector_data.storage < n) {
-        size_t new_storage = calculate_storage(n);
-        T* temp = (T*)malloc(new_storage * sizeof(T));
-        for (size_t index = 0; index < mvector_data.used; ++index) {
-            auto* ele = new (temp + index) T(mvector_data.begin[index]);
-        }
-
-        mvector_data.destroy_memory();
-        mvector_data.begin = temp;
-        mvector_data.storage = new_storage;
+        mvector_data.reallocate(grown_storage(n));
     }
 }
 
-template <typename T>
-void vector<T>::shrink_to_fit() {
-    size_t new_storage = calculate_storage(mvector_data.used);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::shrink_to_fit() {
+    size_t new_storage = std::max(
+        GrowthPolicy::capacity(0, mvector_data.used, sizeof(T)), N);
     if (new_storage != mvector_data.storage) {
-        T* temp = (T*)malloc(new_storage * sizeof(T));
-
-        for (size_t index = 0; index < mvector_data.used; ++index) {
-            auto* ele = new (temp + index) T(mvector_data.begin[index]);
-        }
-
-        mvector_data.destroy_memory();
-        mvector_data.begin = temp;
-        mvector_data.storage = new_storage;
+        mvector_data.reallocate(new_storage);
     }
 }
 
-template <typename T>
-T& vector<T>::operator[](size_t n) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T& vector<T, Allocator, GrowthPolicy, N>::operator[](size_t n) {
     return mvector_data.begin[n];
 }
 
-template <typename T>
-const T& vector<T>::operator[](size_t n) const {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+const T& vector<T, Allocator, GrowthPolicy, N>::operator[](size_t n) const {
     return mvector_data.begin[n];
 }
 
-template <typename T>
-T& vector<T>::at(size_t n) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T& vector<T, Allocator, GrowthPolicy, N>::at(size_t n) {
     if (n < 0 || n >= mvector_data.used) {
         throw std::out_of_range(".at(): Invalid index!");
     }
     return mvector_data.begin[n];
 }
 
-template <typename T>
-const T& vector<T>::at(size_t n) const {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+const T& vector<T, Allocator, GrowthPolicy, N>::at(size_t n) const {
     if (n < 0 || n >= mvector_data.used) {
         throw std::out_of_range(".at(): Invalid index!");
     }
     return mvector_data.begin[n];
 }
 
-template <typename T>
-T& vector<T>::front() {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T& vector<T, Allocator, GrowthPolicy, N>::front() {
     return mvector_data.begin[0];
 }
 
-template <typename T>
-const T& vector<T>::front() const {
-    return const_cast<vector<T>*>(this)->front();
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+const T& vector<T, Allocator, GrowthPolicy, N>::front() const {
+    return const_cast<vector<T, Allocator, GrowthPolicy, N>*>(this)->front();
 }
 
-template <typename T>
-T& vector<T>::back() {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T& vector<T, Allocator, GrowthPolicy, N>::back() {
     return mvector_data.begin[mvector_data.used - 1];
 }
 
-template <typename T>
-const T& vector<T>::back() const {
-    return const_cast<vector<T>*>(this)->back();
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+const T& vector<T, Allocator, GrowthPolicy, N>::back() const {
+    return const_cast<vector<T, Allocator, GrowthPolicy, N>*>(this)->back();
 }
 
-template <typename T>
-T* vector<T>::data() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T* vector<T, Allocator, GrowthPolicy, N>::data() noexcept {
     return mvector_data.begin;
 }
 
-template <typename T>
-const T* vector<T>::data() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+const T* vector<T, Allocator, GrowthPolicy, N>::data() const noexcept {
     return mvector_data.begin;
 }
 
-template <typename T>
-void vector<T>::assign(size_t n, const T& val) {
-    *this = vector(n, val);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::assign(size_t n, const T& val) {
+    if (holds(&val)) {
+        T copy(val);
+        assign(n, copy);
+        return;
+    }
+    clear();
+    insert(cend(), n, val);
 }
 
-template <typename T>
-void vector<T>::push_back(const T& val) {
-    if (mvector_data.used == mvector_data.storage) {
-        reserve(mvector_data.used + 1);
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <detail::legacy_input_iterator InputIterator>
+void vector<T, Allocator, GrowthPolicy, N>::assign(InputIterator first,
+                                                   InputIterator last) {
+    if constexpr (detail::legacy_forward_iterator<InputIterator>) {
+        const size_t n = std::distance(first, last);
+        if (n > mvector_data.storage) {
+            release();
+            mvector_data.acquire(n);
+            detail::copy_construct_range(first, last, mvector_data.begin);
+        } else if (n <= mvector_data.used) {
+            // live elements are assigned to, the surplus is destroyed
+            detail::copy_range(first, last, mvector_data.begin);
+            detail::destroy(mvector_data.begin + n, mvector_data.used - n);
+        } else {
+            InputIterator mid = std::next(first, mvector_data.used);
+            detail::copy_range(first, mid, mvector_data.begin);
+            detail::copy_construct_range(
+                mid, last, mvector_data.begin + mvector_data.used);
+        }
+        mvector_data.used = n;
+    } else {
+        clear();
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
     }
-    auto* ele = new (mvector_data.begin + mvector_data.used) T(val);
-    mvector_data.used++;
 }
 
-template <typename T>
-void vector<T>::push_back(T&& val) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::assign(
+    std::initializer_list<T> il) {
+    assign(il.begin(), il.end());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <detail::legacy_input_iterator InputIterator>
+void vector<T, Allocator, GrowthPolicy, N>::append(InputIterator first,
+                                                   InputIterator last) {
+    insert(cend(), first, last);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::append(
+    std::initializer_list<T> il) {
+    insert(cend(), il.begin(), il.end());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::push_back(const T& val) {
+    emplace_back(val);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::push_back(T&& val) {
+    emplace_back(std::move(val));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+T* vector<T, Allocator, GrowthPolicy, N>::prepare_append(size_t n) {
+    reserve(mvector_data.used + n);
+    return mvector_data.begin + mvector_data.used;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::commit_append(size_t n) {
+    if (n > mvector_data.storage - mvector_data.used) {
+        throw std::out_of_range(".commit_append(): Exceeds capacity!");
+    }
+    mvector_data.used += n;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <typename... Args>
+T& vector<T, Allocator, GrowthPolicy, N>::emplace_back(Args&&... args) {
     if (mvector_data.used == mvector_data.storage) {
-        reserve(mvector_data.used + 1);
+        mvector_data.reallocate(
+            grown_storage(mvector_data.used + 1), mvector_data.used, 1,
+            [&](T* gap) { new (gap) T(std::forward<Args>(args)...); });
+    } else {
+        new (mvector_data.begin + mvector_data.used)
+            T(std::forward<Args>(args)...);
+        mvector_data.used++;
+    }
+    return back();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <typename... Args>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::emplace(
+    const_iterator position, Args&&... args) {
+    const size_t index = position - cbegin();
+    if (index == mvector_data.used) {
+        emplace_back(std::forward<Args>(args)...);
+    } else if (mvector_data.used == mvector_data.storage) {
+        mvector_data.reallocate(
+            grown_storage(mvector_data.used + 1), index, 1,
+            [&](T* gap) { new (gap) T(std::forward<Args>(args)...); });
+    } else if constexpr (is_trivially_relocatable_v<T>) {
+        // args may refer to the elements about to be shifted, so the new
+        // element is built aside and relocated into the gap afterwards
+        alignas(T) unsigned char buffer[sizeof(T)];
+        new (buffer) T(std::forward<Args>(args)...);
+        mvector_data.open_gap(index, 1);
+        memcpy(mvector_data.begin + index, buffer, sizeof(T));
+    } else {
+        T temp(std::forward<Args>(args)...);
+        insert_in_place(index, std::move(temp));
+    }
+    return iterator(mvector_data.begin + index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::insert(
+    const_iterator position, const T& val) {
+    return emplace(position, val);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::insert(
+    const_iterator position, T&& val) {
+    const size_t index = position - cbegin();
+    if constexpr (!is_trivially_relocatable_v<T>) {
+        if (index != mvector_data.used &&
+            mvector_data.used != mvector_data.storage) {
+            insert_in_place(index, std::move(val));
+            return iterator(mvector_data.begin + index);
+        }
+    }
+    return emplace(position, std::move(val));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::insert(
+    const_iterator position, size_t n, const T& val) {
+    const size_t index = position - cbegin();
+    if (n == 0) {
+        return iterator(mvector_data.begin + index);
+    }
+    if (holds(&val)) {
+        T copy(val);
+        return insert(position, n, copy);
     }
-    auto* ele =
-        new (mvector_data.begin + mvector_data.used) T(std::forward<T>(val));
+    if (mvector_data.used + n > mvector_data.storage) {
+        mvector_data.reallocate(grown_storage(mvector_data.used + n),
+                                index, n, [&](T* gap) {
+                                    std::uninitialized_fill_n(gap, n, val);
+                                });
+    } else {
+        insert_in_place(index, n, val);
+    }
+    return iterator(mvector_data.begin + index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <detail::legacy_input_iterator InputIterator>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::insert(
+    const_iterator position, InputIterator first, InputIterator last) {
+    const size_t index = position - cbegin();
+    if constexpr (detail::legacy_forward_iterator<InputIterator>) {
+        const size_t n = std::distance(first, last);
+        if (n == 0) {
+            return iterator(mvector_data.begin + index);
+        }
+        // not used + n > storage, which GCC cannot rule out to wrap around
+        // and then warns about the copy into the gap
+        if (n > mvector_data.storage - mvector_data.used) {
+            mvector_data.reallocate(
+                grown_storage(mvector_data.used + n), index, n,
+                [&](T* gap) {
+                    detail::copy_construct_range(first, last, gap);
+                });
+        } else {
+            insert_in_place(index, n, first, last);
+        }
+    } else {
+        // single pass: append, then rotate the new tail into place
+        const size_t old_size = mvector_data.used;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        std::rotate(mvector_data.begin + index,
+                    mvector_data.begin + old_size,
+                    mvector_data.begin + mvector_data.used);
+    }
+    return iterator(mvector_data.begin + index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::insert(
+    const_iterator position, std::initializer_list<T> il) {
+    return insert(position, il.begin(), il.end());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <typename ForwardIterator>
+void vector<T, Allocator, GrowthPolicy, N>::insert_in_place(
+    size_t index, size_t n, ForwardIterator first, ForwardIterator last) {
+    T* pos = mvector_data.begin + index;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        mvector_data.open_gap(index, n);
+        try {
+            detail::copy_construct_range(first, last, pos);
+        } catch (...) {
+            mvector_data.close_gap(index, n);
+            throw;
+        }
+    } else {
+        T* old_end = mvector_data.begin + mvector_data.used;
+        const size_t elems_after = mvector_data.used - index;
+        if (elems_after > n) {
+            std::uninitialized_move(old_end - n, old_end, old_end);
+            mvector_data.used += n;
+            std::move_backward(pos, old_end - n, old_end);
+            std::copy(first, last, pos);
+        } else {
+            ForwardIterator mid = std::next(first, elems_after);
+            std::uninitialized_copy(mid, last, old_end);
+            mvector_data.used += n - elems_after;
+            std::uninitialized_move(pos, old_end,
+                                    mvector_data.begin + mvector_data.used);
+            mvector_data.used += elems_after;
+            std::copy(first, mid, pos);
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::insert_in_place(
+    size_t index, size_t n, const T& val) {
+    T* pos = mvector_data.begin + index;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        mvector_data.open_gap(index, n);
+        try {
+            std::uninitialized_fill_n(pos, n, val);
+        } catch (...) {
+            mvector_data.close_gap(index, n);
+            throw;
+        }
+    } else {
+        T* old_end = mvector_data.begin + mvector_data.used;
+        const size_t elems_after = mvector_data.used - index;
+        if (elems_after > n) {
+            std::uninitialized_move(old_end - n, old_end, old_end);
+            mvector_data.used += n;
+            std::move_backward(pos, old_end - n, old_end);
+            std::fill_n(pos, n, val);
+        } else {
+            std::uninitialized_fill_n(old_end, n - elems_after, val);
+            mvector_data.used += n - elems_after;
+            std::uninitialized_move(pos, old_end,
+                                    mvector_data.begin + mvector_data.used);
+            mvector_data.used += elems_after;
+            std::fill(pos, old_end, val);
+        }
+    }
+}
+
+// Shifts the tail one place to the right through moves and move-assigns
+// val into the hole; the caller guarantees spare capacity.
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::insert_in_place(
+    size_t index, T&& val) {
+    T* pos = mvector_data.begin + index;
+    T* old_end = mvector_data.begin + mvector_data.used;
+    new (old_end) T(std::move(*(old_end - 1)));
     mvector_data.used++;
+    std::move_backward(pos, old_end - 1, old_end);
+    *pos = std::move(val);
 }
 
-template <typename T>
-void vector<T>::pop_back() {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::erase(const_iterator position) {
+    return erase(position, position + 1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+typename vector<T, Allocator, GrowthPolicy, N>::iterator
+vector<T, Allocator, GrowthPolicy, N>::erase(
+    const_iterator first, const_iterator last) {
+    const size_t index = first - cbegin();
+    const size_t n = last - first;
+    if (n) {
+        T* pos = mvector_data.begin + index;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            detail::destroy(pos, n);
+            mvector_data.close_gap(index, n);
+        } else {
+            std::move(pos + n, mvector_data.begin + mvector_data.used, pos);
+            detail::destroy(mvector_data.begin + mvector_data.used - n, n);
+            mvector_data.used -= n;
+        }
+    }
+    return iterator(mvector_data.begin + index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::pop_back() {
     mvector_data.begin[mvector_data.used - 1].~T();
     mvector_data.used--;
 }
 
-template <typename T>
-void vector<T>::swap(vector& x) {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::swap(vector& x) {
+    if constexpr (N != 0) {
+        if (mvector_data.is_inline() || x.mvector_data.is_inline()) {
+            // inline elements cannot trade places by swapping pointers
+            vector temp(std::move(x));
+            x = std::move(*this);
+            *this = std::move(temp);
+            return;
+        }
+    }
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(mvector_data.alloc, x.mvector_data.alloc);
+    }
     std::swap(mvector_data.begin, x.mvector_data.begin);
     std::swap(mvector_data.used, x.mvector_data.used);
     std::swap(mvector_data.storage, x.mvector_data.storage);
 }
 
-template <typename T>
-void vector<T>::clear() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::clear() noexcept {
     for (auto index = 0; index < mvector_data.used; ++index) {
         mvector_data.begin[index].~T();
     }
     mvector_data.used = 0;
 }
 
-template <typename T>
-typename vector<T>::iterator operator+(
-    typename vector<T>::iterator::difference_type dist,
-    const typename vector<T>::iterator& iter) {
-    return iter + dist;
-}
-
-template <typename T>
-typename vector<T>::const_iterator operator+(
-    typename vector<T>::const_iterator::difference_type dist,
-    const typename vector<T>::const_iterator& iter) {
-    return iter + dist;
+#if defined(__GLIBCXX__)
+// Argument-dependent lookup does not reach std::swap for the
+// __normal_iterator of a vector, see detail::pointer_iterator.
+template <typename Pointer, typename T, typename Allocator,
+          typename GrowthPolicy, size_t N>
+void swap(__gnu_cxx::__normal_iterator<
+              Pointer, vector<T, Allocator, GrowthPolicy, N>>& lhs,
+          __gnu_cxx::__normal_iterator<
+              Pointer, vector<T, Allocator, GrowthPolicy, N>>& rhs) noexcept {
+    std::swap(lhs, rhs);
 }
+#endif
 
-}  // namespace cpp::common::container
\ No newline at end of file
+}  // namespace cpp::common::container
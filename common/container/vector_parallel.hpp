@@ -0,0 +1,194 @@
+#pragma once
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+namespace cpp::common::container {
+
+/*
+ * Tag asking for a large range of elements to be constructed, filled,
+ * copied or destroyed by the threads of a thread_pool, by default
+ * thread_pool::shared(). Every thread works on its own slice of whole
+ * pages, so freshly allocated pages are first touched, and on NUMA
+ * systems placed, by the thread that works on them. Ranges that would give
+ * a thread less than detail::parallel_min_bytes stay on fewer threads.
+ * The overloads of vector that take it are declared in vector.hpp and
+ * defined here, so that only users of this header pull in <thread>.
+ *
+ *     vector<double> samples(n, 0.0, parallel);
+ *     vector<double> copy(samples, parallel_t(&pool));
+ */
+struct parallel_t {
+    explicit constexpr parallel_t(thread_pool* pool = nullptr) noexcept
+        : pool(pool) {}
+    thread_pool& get_pool() const {
+        return pool ? *pool : thread_pool::shared();
+    }
+    thread_pool* pool;
+};
+inline constexpr parallel_t parallel{};
+
+namespace detail {
+
+inline constexpr size_t parallel_min_bytes = size_t(1) << 20;
+
+struct slice_plan {
+    size_t length;
+    size_t count;
+};
+
+// Splits n elements of T into at most one slice per thread of the pool,
+// each a multiple of a 4 KiB page long and none below parallel_min_bytes.
+template <typename T>
+slice_plan plan_slices(const thread_pool& pool, size_t n) {
+    const size_t page = std::max<size_t>(1, 4096 / sizeof(T));
+    const size_t threads = std::clamp<size_t>(
+        n / std::max<size_t>(1, parallel_min_bytes / sizeof(T)), 1,
+        pool.concurrency());
+    size_t length = (n + threads - 1) / threads;
+    length = std::max<size_t>(1, (length + page - 1) / page * page);
+    return {length, (n + length - 1) / length};
+}
+
+/*
+ * Runs construct(dst + first, count) on the slices of [dst, dst + n) in
+ * parallel. construct must build either all count elements or none. If a
+ * slice throws, the slices that were built are destroyed again and the
+ * exception is rethrown.
+ */
+template <typename T, typename Construct>
+void parallel_construct(thread_pool& pool, T* dst, size_t n,
+                        Construct&& construct) {
+    const slice_plan plan = plan_slices<T>(pool, n);
+    std::unique_ptr<bool[]> built(new bool[plan.count]());
+    try {
+        pool.parallel_for(plan.count, [&](size_t i) {
+            const size_t first = i * plan.length;
+            construct(dst + first, std::min(plan.length, n - first));
+            built[i] = true;
+        });
+    } catch (...) {
+        for (size_t i = 0; i < plan.count; ++i) {
+            if (built[i]) {
+                const size_t first = i * plan.length;
+                destroy(dst + first, std::min(plan.length, n - first));
+            }
+        }
+        throw;
+    }
+}
+
+template <typename T>
+void parallel_destroy(thread_pool& pool, T* first, size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        const slice_plan plan = plan_slices<T>(pool, n);
+        pool.parallel_for(plan.count, [&](size_t i) {
+            const size_t offset = i * plan.length;
+            destroy(first + offset, std::min(plan.length, n - offset));
+        });
+    }
+}
+
+}  // namespace detail
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(size_t n, parallel_t par,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    resize(n, par);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(size_t n, const T& val,
+                                              parallel_t par,
+                                              const Allocator& alloc)
+    : mvector_data(alloc) {
+    resize(n, val, par);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+vector<T, Allocator, GrowthPolicy, N>::vector(const vector& rhs,
+                                              parallel_t par)
+    : mvector_data(alloc_traits::select_on_container_copy_construction(
+          rhs.mvector_data.alloc)) {
+    mvector_data.acquire(rhs.mvector_data.used > N ? rhs.mvector_data.storage
+                                                   : 0);
+    parallel_grow(rhs.mvector_data.used, par, [&](T* first, size_t count) {
+        const T* src = rhs.mvector_data.begin + (first - mvector_data.begin);
+        detail::copy_construct_range(src, src + count, first);
+    });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+template <typename Construct>
+void vector<T, Allocator, GrowthPolicy, N>::parallel_grow(
+    size_t n, parallel_t par, Construct&& construct) {
+    if (mvector_data.used == 0 && n > mvector_data.storage) {
+        // nothing to keep: allocate exactly n, as the serial constructors do
+        release();
+        mvector_data.acquire(n);
+    } else {
+        reserve(n);
+    }
+    T* tail = mvector_data.begin + mvector_data.used;
+    detail::parallel_construct(par.get_pool(), tail, n - mvector_data.used,
+                               construct);
+    mvector_data.used = n;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::resize(size_t n, parallel_t par) {
+    if (n > mvector_data.used) {
+        parallel_grow(n, par, [](T* first, size_t count) {
+            std::uninitialized_value_construct_n(first, count);
+        });
+    } else {
+        detail::parallel_destroy(par.get_pool(), mvector_data.begin + n,
+                                 mvector_data.used - n);
+        mvector_data.used = n;
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::resize(size_t n, const T& val,
+                                                   parallel_t par) {
+    if (n > mvector_data.used) {
+        if (holds(&val) && n > mvector_data.storage) {
+            T copy(val);
+            resize(n, copy, par);
+            return;
+        }
+        parallel_grow(n, par, [&](T* first, size_t count) {
+            std::uninitialized_fill_n(first, count, val);
+        });
+    } else {
+        detail::parallel_destroy(par.get_pool(), mvector_data.begin + n,
+                                 mvector_data.used - n);
+        mvector_data.used = n;
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::assign(size_t n, const T& val,
+                                                   parallel_t par) {
+    if (holds(&val)) {
+        T copy(val);
+        assign(n, copy, par);
+        return;
+    }
+    clear(par);
+    resize(n, val, par);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t N>
+void vector<T, Allocator, GrowthPolicy, N>::clear(parallel_t par) {
+    detail::parallel_destroy(par.get_pool(), mvector_data.begin,
+                             mvector_data.used);
+    mvector_data.used = 0;
+}
+
+}  // namespace cpp::common::container
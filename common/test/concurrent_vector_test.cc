@@ -0,0 +1,113 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <container/concurrent_vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(ConcurrentVectorTest, PushBackAndIterate) {
+    container::concurrent_vector<std::string> vec;
+    EXPECT_TRUE(vec.empty());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(vec.push_back(std::to_string(i)), i);
+    }
+    EXPECT_EQ(vec.size(), 100);
+    EXPECT_EQ(vec[42], "42");
+    EXPECT_EQ(vec.at(99), "99");
+    EXPECT_THROW(vec.at(100), std::out_of_range);
+    int expected = 0;
+    for (const auto& ele : vec) {
+        EXPECT_EQ(ele, std::to_string(expected++));
+    }
+    EXPECT_EQ(vec.end() - vec.begin(), 100);
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.begin() + 10));
+}
+
+TEST(ConcurrentVectorTest, ElementsNeverMove) {
+    container::concurrent_vector<int> vec;
+    vec.emplace_back(1);
+    const int* first = &vec[0];
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(&vec[0], first);
+    EXPECT_EQ(*first, 1);
+}
+
+TEST(ConcurrentVectorTest, ConcurrentAppends) {
+    constexpr int threads = 8;
+    constexpr int perThread = 20000;
+    container::concurrent_vector<int> vec;
+    std::atomic<bool> done = false;
+    // a reader that checks every element while the writers run
+    std::thread reader([&] {
+        while (!done.load()) {
+            for (int value : vec) {
+                ASSERT_LT(value, threads * perThread);
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&vec, t] {
+            for (int i = 0; i < perThread; ++i) {
+                vec.push_back(t * perThread + i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(vec.size(), threads * perThread);
+    std::vector<int> values(vec.begin(), vec.end());
+    std::sort(values.begin(), values.end());
+    for (int i = 0; i < threads * perThread; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+namespace {
+struct ThrowOnNegative {
+    explicit ThrowOnNegative(int v) : value(std::to_string(v)) {
+        if (v < 0) throw std::invalid_argument("negative");
+    }
+    std::string value;
+};
+}  // namespace
+
+TEST(ConcurrentVectorTest, ThrowingConstructorLeavesNoGap) {
+    container::concurrent_vector<ThrowOnNegative> vec;
+    EXPECT_EQ(vec.emplace_back(1), 0);
+    EXPECT_THROW(vec.emplace_back(-1), std::invalid_argument);
+    EXPECT_EQ(vec.emplace_back(2), 1);
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_TRUE(vec.is_ready(1));
+    EXPECT_FALSE(vec.is_ready(2));
+    EXPECT_THROW(vec.at(2), std::out_of_range);
+    std::vector<std::string> values;
+    for (const auto& ele : vec) {
+        values.push_back(ele.value);
+    }
+    EXPECT_THAT(values, ElementsAre("1", "2"));
+}
+
+TEST(ConcurrentVectorTest, Reserve) {
+    container::concurrent_vector<int> vec;
+    vec.reserve(100);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_FALSE(vec.is_ready(0));
+    vec.push_back(5);
+    EXPECT_TRUE(vec.is_ready(0));
+}
+
+}  // namespace cpp::common::test
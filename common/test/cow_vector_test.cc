@@ -0,0 +1,102 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <container/cow_vector.hpp>
+#include <string>
+#include <thread>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(CowVectorTest, CopiesShareUntilMutated) {
+    container::cow_vector<std::string> table{"a", "b"};
+    container::cow_vector<std::string> snapshot = table;
+    EXPECT_EQ(snapshot.data(), table.data());
+    EXPECT_FALSE(table.unique());
+
+    table.push_back("c");
+    EXPECT_NE(snapshot.data(), table.data());
+    EXPECT_TRUE(table.unique());
+    EXPECT_THAT(snapshot, ElementsAre("a", "b"));
+    EXPECT_THAT(table, ElementsAre("a", "b", "c"));
+
+    // a sole owner edits in place
+    const std::string* data = table.data();
+    table.edit()[0] = "z";
+    EXPECT_EQ(data, table.data());
+    EXPECT_EQ(table[0], "z");
+    EXPECT_EQ(snapshot[0], "a");
+}
+
+TEST(CowVectorTest, EmptyAndClear) {
+    container::cow_vector<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+    container::cow_vector<int> table{1, 2, 3};
+    container::cow_vector<int> snapshot = table;
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_EQ(table, empty);
+    EXPECT_THAT(snapshot, ElementsAre(1, 2, 3));
+    table.emplace_back(4);
+    EXPECT_THAT(table, ElementsAre(4));
+}
+
+TEST(CowVectorTest, EditsInPlaceAfterOtherThreadReleases) {
+    for (int round = 0; round < 100; ++round) {
+        container::cow_vector<int> table{1, 2, 3};
+        auto* copy = new container::cow_vector<int>(table);
+        const int* data = table.data();
+        std::atomic<int> sum = 0;
+        std::thread reader([&] {
+            sum = (*copy)[0] + (*copy)[1] + (*copy)[2];
+            delete copy;
+        });
+        while (!table.unique()) {
+            std::this_thread::yield();
+        }
+        // the reader's accesses happen before this write to the same buffer
+        table.edit()[0] = 4;
+        reader.join();
+        EXPECT_EQ(sum, 6);
+        EXPECT_EQ(table.data(), data);
+        EXPECT_THAT(table, ElementsAre(4, 2, 3));
+    }
+}
+
+TEST(CowVectorTest, SnapshotsSeeConsistentVersions) {
+    container::atomic_cow_vector<int> published;
+    constexpr int versions = 200;
+    std::atomic<bool> done = false;
+    std::thread reader([&] {
+        while (!done.load()) {
+            auto snapshot = published.load();
+            // every version n holds 0 .. n-1
+            for (size_t i = 0; i < snapshot.size(); ++i) {
+                ASSERT_EQ(snapshot[i], i);
+            }
+        }
+    });
+    auto appendIndex = [](auto& table) { table.push_back(table.size()); };
+    std::thread writer([&] {
+        for (int i = 0; i < versions / 2; ++i) {
+            published.update(appendIndex);
+        }
+    });
+    for (int i = 0; i < versions / 2; ++i) {
+        published.update(appendIndex);
+    }
+    writer.join();
+    done = true;
+    reader.join();
+    auto last = published.load();
+    ASSERT_EQ(last.size(), versions);
+    EXPECT_EQ(last.back(), versions - 1);
+
+    container::cow_vector<int> replacement{7};
+    published.store(replacement);
+    EXPECT_EQ(published.load().data(), replacement.data());
+}
+
+}  // namespace cpp::common::test
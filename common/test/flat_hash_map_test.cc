@@ -0,0 +1,159 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/flat_hash_map.hpp>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const {
+        return std::hash<std::string_view>()(key);
+    }
+};
+}  // namespace
+
+TEST(FlatHashMapTest, InsertFindErase) {
+    container::flat_hash_map<std::string, int> map{{"a", 1}, {"b", 2}};
+    EXPECT_TRUE(map.insert({"c", 3}).second);
+    EXPECT_FALSE(map.try_emplace("a", 10).second);
+    EXPECT_EQ(map["a"], 1);
+    map["d"] = 4;
+    EXPECT_FALSE(map.insert_or_assign("c", 30).second);
+    EXPECT_EQ(map.at("c"), 30);
+    EXPECT_THROW(map.at("x"), std::out_of_range);
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.find("x"), map.end());
+    EXPECT_EQ(map.erase("b"), 1);
+    EXPECT_EQ(map.erase("b"), 0);
+    map.erase(map.find("a"));
+
+    std::map<std::string, int> sorted(map.begin(), map.end());
+    EXPECT_THAT(sorted, ElementsAre(Pair("c", 30), Pair("d", 4)));
+    auto copy = map;
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.at("d"), 4);
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap) {
+    std::mt19937 generator(5);
+    container::flat_hash_map<int, int> map;
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 20000; ++i) {
+        const int key = generator() % 2000;
+        if (generator() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), reference.erase(key));
+        } else {
+            EXPECT_EQ(map.try_emplace(key, i).second,
+                      reference.try_emplace(key, i).second);
+        }
+    }
+    EXPECT_EQ(map.size(), reference.size());
+    for (int key = 0; key < 2000; ++key) {
+        auto it = reference.find(key);
+        if (it == reference.end()) {
+            EXPECT_FALSE(map.contains(key));
+        } else {
+            EXPECT_EQ(map.at(key), it->second);
+        }
+    }
+    size_t visited = 0;
+    for (const auto& [key, value] : map) {
+        EXPECT_EQ(reference.at(key), value);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(FlatHashMapTest, ReserveAvoidsRehash) {
+    std::mt19937 generator(3);
+    for (size_t reserved : {100, 7000}) {
+        container::flat_hash_map<int, std::unique_ptr<int>> map;
+        map.reserve(reserved);
+        const size_t capacity = map.capacity();
+        // fill to the load limit, then replace random keys so that
+        // tombstones pile up
+        const size_t limit = capacity - capacity / 8;
+        EXPECT_LE(reserved, limit);
+        std::vector<int> keys;
+        for (int key = 0; keys.size() < limit; ++key) {
+            map.try_emplace(key, std::make_unique<int>(key));
+            keys.push_back(key);
+        }
+        int next = int(limit);
+        for (size_t i = 0; i < 20 * limit; ++i) {
+            int& key = keys[generator() % keys.size()];
+            ASSERT_EQ(map.erase(key), 1);
+            key = next++;
+            map.try_emplace(key, std::make_unique<int>(key));
+        }
+        EXPECT_EQ(map.size(), limit);
+        EXPECT_EQ(map.capacity(), capacity);
+        for (int key : keys) {
+            ASSERT_EQ(*map.at(key), key);
+        }
+    }
+}
+
+TEST(FlatHashMapTest, HeterogeneousLookup) {
+    container::flat_hash_map<std::string, int, StringHash, std::equal_to<>>
+        map;
+    map["route"] = 1;
+    std::string_view key = "route";
+    EXPECT_TRUE(map.contains(key));
+    EXPECT_EQ(map.find(key)->second, 1);
+    EXPECT_EQ(map.count(std::string_view("other")), 0);
+}
+
+namespace {
+// Starts each copy of a container afresh with tag 0.
+template <typename T>
+struct FreshOnCopyAllocator : container::malloc_allocator<T> {
+    typedef std::false_type is_always_equal;
+    template <typename U>
+    struct rebind {
+        typedef FreshOnCopyAllocator<U> other;
+    };
+
+    FreshOnCopyAllocator(int tag) : mTag(tag) {}
+    template <typename U>
+    FreshOnCopyAllocator(const FreshOnCopyAllocator<U>& rhs)
+        : mTag(rhs.mTag) {}
+    FreshOnCopyAllocator select_on_container_copy_construction() const {
+        return FreshOnCopyAllocator(0);
+    }
+    bool operator==(const FreshOnCopyAllocator& rhs) const {
+        return mTag == rhs.mTag;
+    }
+    int mTag;
+};
+}  // namespace
+
+TEST(FlatHashMapTest, CopyFollowsAllocatorCopyPolicy) {
+    typedef FreshOnCopyAllocator<std::pair<const int, int>> Allocator;
+    container::flat_hash_map<int, int, std::hash<int>, std::equal_to<int>,
+                             Allocator>
+        map(4, {}, {}, Allocator(1));
+    map[1] = 10;
+    map[2] = 20;
+    auto copy = map;
+    EXPECT_EQ(map.get_allocator().mTag, 1);
+    EXPECT_EQ(copy.get_allocator().mTag, 0);
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.at(2), 20);
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,111 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/flat_map.hpp>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(FlatMapTest, InsertLookupErase) {
+    container::flat_map<std::string, int> map{{"b", 2}, {"a", 1}, {"b", 3}};
+    EXPECT_THAT(map.keys(), ElementsAre("a", "b"));
+    EXPECT_THAT(map.values(), ElementsAre(1, 2));
+    EXPECT_TRUE(map.insert({"c", 3}).second);
+    EXPECT_FALSE(map.try_emplace("a", 10).second);
+    EXPECT_EQ(map["a"], 1);
+    map["d"] = 4;
+    EXPECT_FALSE(map.insert_or_assign("c", 30).second);
+    EXPECT_EQ(map.at("c"), 30);
+    EXPECT_THROW(map.at("x"), std::out_of_range);
+
+    auto it = map.find("b");
+    EXPECT_EQ(it->first, "b");
+    it->second = 20;
+    EXPECT_EQ(map.lower_bound("bb")->first, "c");
+    EXPECT_EQ(map.upper_bound("c")->first, "d");
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_EQ(map.erase("a"), 0);
+    it = map.erase(map.begin());
+    EXPECT_EQ(it->first, "c");
+    std::vector<std::pair<std::string, int>> entries(map.begin(), map.end());
+    EXPECT_THAT(entries, ElementsAre(Pair("c", 30), Pair("d", 4)));
+}
+
+TEST(FlatMapTest, BulkInsertMatchesStdMap) {
+    std::mt19937 generator(11);
+    container::flat_map<int, int> map;
+    std::map<int, int> reference;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<int, int>> batch(generator() % 30);
+        for (auto& entry : batch) {
+            entry = {int(generator() % 100), round};
+        }
+        map.insert(batch.begin(), batch.end());
+        reference.insert(batch.begin(), batch.end());
+        ASSERT_TRUE(std::equal(map.begin(), map.end(), reference.begin(),
+                               reference.end(),
+                               [](const auto& lhs, const auto& rhs) {
+                                   return lhs.first == rhs.first &&
+                                          lhs.second == rhs.second;
+                               }));
+    }
+}
+
+TEST(FlatMapTest, ReplaceAndExtract) {
+    container::vector<int> keys{1, 2, 3};
+    container::vector<std::unique_ptr<int>> values;
+    for (int key : keys) {
+        values.push_back(std::make_unique<int>(key * 10));
+    }
+    const int* keyData = keys.data();
+    const int* value = values[1].get();
+
+    container::flat_map<int, std::unique_ptr<int>> map;
+    map.replace(std::move(keys), std::move(values));
+    EXPECT_EQ(map.keys().data(), keyData);
+    EXPECT_EQ(map.at(2).get(), value);
+    map.try_emplace(0, std::make_unique<int>(0));
+    EXPECT_THAT(map.keys(), ElementsAre(0, 1, 2, 3));
+
+    auto extracted = std::move(map).extract();
+    EXPECT_TRUE(map.empty());
+    EXPECT_THAT(extracted.keys, ElementsAre(0, 1, 2, 3));
+    EXPECT_EQ(*extracted.values[3], 30);
+}
+
+TEST(FlatMapTest, FailedBulkInsertKeepsEntries) {
+    // copying a negative value throws
+    struct Fragile {
+        int value;
+        Fragile(int value) : value(value) {}
+        Fragile(const Fragile& rhs) : value(rhs.value) {
+            if (value < 0) {
+                throw std::runtime_error("copy");
+            }
+        }
+        Fragile(Fragile&&) noexcept = default;
+        Fragile& operator=(const Fragile&) = default;
+        Fragile& operator=(Fragile&&) noexcept = default;
+    };
+    container::flat_map<int, Fragile> map;
+    map.try_emplace(3, 30);
+    map.try_emplace(1, 10);
+    std::vector<std::pair<int, Fragile>> entries;
+    entries.emplace_back(2, 20);
+    entries.emplace_back(0, -1);
+    EXPECT_THROW(map.insert(entries.begin(), entries.end()),
+                 std::runtime_error);
+    EXPECT_THAT(map.keys(), ElementsAre(1, 3));
+    ASSERT_EQ(map.values().size(), 2);
+    EXPECT_EQ(map.values()[0].value, 10);
+    EXPECT_EQ(map.values()[1].value, 30);
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,96 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <container/flat_set.hpp>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(FlatSetTest, InsertFindErase) {
+    container::flat_set<std::string> set{"b", "d", "a", "b"};
+    EXPECT_THAT(set, ElementsAre("a", "b", "d"));
+    EXPECT_TRUE(set.insert("c").second);
+    EXPECT_FALSE(set.insert("a").second);
+    EXPECT_THAT(set, ElementsAre("a", "b", "c", "d"));
+    EXPECT_TRUE(set.contains("c"));
+    EXPECT_EQ(set.find("x"), set.end());
+    EXPECT_EQ(*set.lower_bound("bb"), "c");
+    EXPECT_EQ(*set.upper_bound("b"), "c");
+    EXPECT_EQ(set.erase("b"), 1);
+    EXPECT_EQ(set.erase("b"), 0);
+    EXPECT_THAT(set, ElementsAre("a", "c", "d"));
+}
+
+TEST(FlatSetTest, BoundsMatchStd) {
+    std::mt19937 generator(7);
+    for (size_t n = 0; n < 40; ++n) {
+        std::vector<int> keys(n);
+        for (auto& key : keys) {
+            key = generator() % 50;
+        }
+        container::flat_set<int> set(keys.begin(), keys.end());
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        ASSERT_TRUE(std::equal(set.begin(), set.end(), keys.begin(),
+                               keys.end()));
+        for (int key = -1; key <= 51; ++key) {
+            EXPECT_EQ(set.lower_bound(key) - set.begin(),
+                      std::lower_bound(keys.begin(), keys.end(), key) -
+                          keys.begin());
+            EXPECT_EQ(set.upper_bound(key) - set.begin(),
+                      std::upper_bound(keys.begin(), keys.end(), key) -
+                          keys.begin());
+        }
+    }
+}
+
+TEST(FlatSetTest, BulkInsertAndReplace) {
+    container::flat_set<int, std::greater<int>> set{5, 1};
+    std::vector<int> more{3, 5, 7, 3};
+    set.insert(more.begin(), more.end());
+    EXPECT_THAT(set, ElementsAre(7, 5, 3, 1));
+    std::vector<int> sorted{9, 6, 1};
+    set.insert(container::sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_THAT(set, ElementsAre(9, 7, 6, 5, 3, 1));
+
+    container::vector<int> keys = std::move(set).extract();
+    EXPECT_TRUE(set.empty());
+    const int* data = keys.data();
+    keys.pop_back();
+    set.replace(std::move(keys));
+    EXPECT_EQ(&*set.begin(), data);
+    EXPECT_THAT(set, ElementsAre(9, 7, 6, 5, 3));
+}
+
+TEST(FlatSetTest, FailedBulkInsertKeepsKeys) {
+    // copying a negative value throws
+    struct Fragile {
+        int value;
+        Fragile(int value) : value(value) {}
+        Fragile(const Fragile& rhs) : value(rhs.value) {
+            if (value < 0) {
+                throw std::runtime_error("copy");
+            }
+        }
+        Fragile(Fragile&&) noexcept = default;
+        Fragile& operator=(const Fragile&) = default;
+        Fragile& operator=(Fragile&&) noexcept = default;
+        bool operator<(const Fragile& rhs) const { return value < rhs.value; }
+    };
+    container::flat_set<Fragile> set{Fragile(3), Fragile(1)};
+    std::vector<Fragile> keys;
+    keys.emplace_back(2);
+    keys.emplace_back(-1);
+    EXPECT_THROW(set.insert(keys.begin(), keys.end()), std::runtime_error);
+    ASSERT_EQ(set.size(), 2);
+    EXPECT_EQ(set.begin()->value, 1);
+    EXPECT_EQ(std::next(set.begin())->value, 3);
+}
+
+}  // namespace cpp::common::test
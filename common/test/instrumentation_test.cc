@@ -0,0 +1,116 @@
+// Instrumentation changes the code of every container it is enabled for,
+// so this file only instantiates containers of its own local types.
+#ifndef CPP_CONTAINER_INSTRUMENTATION
+#define CPP_CONTAINER_INSTRUMENTATION
+#endif
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/bvector.hpp>
+#include <container/instrumentation.hpp>
+#include <container/vector.hpp>
+#include <sstream>
+#include <string>
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+// Not trivially relocatable, so growth never goes through realloc, which
+// may or may not move the block.
+struct Sample {
+    std::string value;
+};
+struct Grown {
+    std::string value;
+};
+struct InstrumentedWords {};
+
+const container::container_stats* Find(const std::string& name) {
+    const container::container_stats* found = nullptr;
+    container::instrumentation_registry::instance().for_each(
+        [&](const container::container_stats& stats) {
+            if (stats.name.find(name) != std::string::npos) {
+                found = &stats;
+            }
+        });
+    return found;
+}
+}  // namespace
+
+TEST(InstrumentationTest, CountsVectorBuffers) {
+    {
+        container::vector<Sample> vec;
+        for (int i = 0; i < 5; ++i) {
+            vec.push_back({std::to_string(i)});
+        }
+        container::vector<Sample> empty;
+    }
+    const auto* stats = Find("Sample");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_THAT(stats->name, HasSubstr("container::vector<"));
+    // capacities 1, 2, 4 and 8; the elements moved for 2, 4 and 8
+    EXPECT_EQ(stats->allocations, 4);
+    EXPECT_EQ(stats->reallocations, 3);
+    EXPECT_EQ(stats->relocated_bytes, (1 + 2 + 4) * sizeof(Sample));
+    EXPECT_EQ(stats->peak_capacity_bytes, 8 * sizeof(Sample));
+    // the three full buffers growth replaced and the last one; the empty
+    // vector never had a buffer
+    EXPECT_EQ(stats->retired, 4);
+    EXPECT_EQ(stats->slack_bytes, 3 * sizeof(Sample));
+    EXPECT_EQ(stats->final_sizes[1], 1);
+    EXPECT_EQ(stats->final_sizes[2], 1);
+    EXPECT_EQ(stats->final_sizes[3], 2);  // 4 and 5 are in [4, 7]
+
+    std::ostringstream dump;
+    container::instrumentation_registry::instance().dump(dump);
+    EXPECT_THAT(dump.str(), HasSubstr("reallocations 3"));
+    EXPECT_THAT(dump.str(), HasSubstr("retired 4"));
+    EXPECT_THAT(dump.str(), HasSubstr("[4,7]=2"));
+}
+
+TEST(InstrumentationTest, RetiresBuffersReplacedByGrowthAndShrink) {
+    {
+        container::vector<Grown> vec;
+        vec.reserve(4);
+        for (int i = 0; i < 20; ++i) {
+            vec.push_back({std::to_string(i)});
+        }
+        vec.resize(3);
+        vec.shrink_to_fit();
+    }
+    const auto* stats = Find("Grown");
+    ASSERT_NE(stats, nullptr);
+    // capacities 4, 8, 16 and 32, then 4 again after shrink_to_fit
+    EXPECT_EQ(stats->allocations, 5);
+    EXPECT_EQ(stats->retired, 5);
+    // 29 unused elements of the 32 when it shrank, 1 of the last 4
+    EXPECT_EQ(stats->slack_bytes, 30 * sizeof(Grown));
+    EXPECT_EQ(stats->final_sizes[2], 2);  // the 3 left, twice
+    EXPECT_EQ(stats->final_sizes[3], 1);
+    EXPECT_EQ(stats->final_sizes[4], 1);
+    EXPECT_EQ(stats->final_sizes[5], 1);
+}
+
+TEST(InstrumentationTest, CountsBitVectorBuffers) {
+    using Bits = container::vector<
+        bool, container::malloc_allocator<InstrumentedWords>>;
+    {
+        Bits bits;
+        bits.reserve(64);
+        bits.push_back(true);
+        bits.reserve(128);
+    }
+    const auto* stats = Find("InstrumentedWords");
+    ASSERT_NE(stats, nullptr);
+    // one 64-bit word, then two
+    EXPECT_EQ(stats->reallocations, 1);
+    EXPECT_EQ(stats->peak_capacity_bytes, 16);
+    EXPECT_EQ(stats->retired, 2);
+    // 63 unused bits of the first word, 127 of the second
+    EXPECT_EQ(stats->slack_bytes, 63 / 8 + 127 / 8);
+    EXPECT_EQ(stats->final_sizes[1], 2);
+}
+
+}  // namespace cpp::common::test
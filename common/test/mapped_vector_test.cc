@@ -0,0 +1,132 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <container/mapped_vector.hpp>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+struct Record {
+    int id;
+    double value;
+};
+
+class MappedVectorTest : public Test {
+   protected:
+    void SetUp() override {
+        mPath = (std::filesystem::temp_directory_path() /
+                 ("mapped_vector_test." + std::to_string(getpid()) + "." +
+                  UnitTest::GetInstance()->current_test_info()->name()))
+                    .string();
+        std::filesystem::remove(mPath);
+    }
+    void TearDown() override { std::filesystem::remove(mPath); }
+    size_t FileSize() const { return std::filesystem::file_size(mPath); }
+
+    std::string mPath;
+};
+}  // namespace
+
+TEST_F(MappedVectorTest, AppendAndReopen) {
+    {
+        container::mapped_vector<Record> vec(mPath);
+        EXPECT_TRUE(vec.empty());
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back({i, i * 0.5});
+        }
+        EXPECT_EQ(vec.size(), 1000);
+        EXPECT_GE(vec.capacity(), 1000);
+    }
+    // the spare capacity is trimmed on close
+    EXPECT_EQ(FileSize(), 1000 * sizeof(Record));
+
+    const container::mapped_vector<Record> vec(mPath,
+                                               container::map_mode::read_only);
+    EXPECT_EQ(vec.size(), 1000);
+    int expected = 0;
+    for (const Record& record : vec) {
+        EXPECT_EQ(record.id, expected);
+        EXPECT_EQ(record.value, expected * 0.5);
+        ++expected;
+    }
+    EXPECT_EQ(vec.back().id, 999);
+    EXPECT_THROW(vec.at(1000), std::out_of_range);
+}
+
+TEST_F(MappedVectorTest, Flush) {
+    container::mapped_vector<int> vec(mPath);
+    vec.reserve(100);
+    EXPECT_EQ(FileSize(), 100 * sizeof(int));
+    int values[] = {1, 2, 3};
+    vec.append(values, values + 3);
+    vec.flush();
+    EXPECT_EQ(vec.capacity(), 3);
+    EXPECT_EQ(FileSize(), 3 * sizeof(int));
+
+    FILE* file = fopen(mPath.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    int onDisk[3] = {};
+    EXPECT_EQ(fread(onDisk, sizeof(int), 3, file), 3);
+    fclose(file);
+    EXPECT_THAT(onDisk, ElementsAre(1, 2, 3));
+
+    // growing again after the trim
+    vec.push_back(vec[0]);
+    EXPECT_THAT(vec, ElementsAre(1, 2, 3, 1));
+}
+
+TEST_F(MappedVectorTest, ResizeAndClear) {
+    {
+        container::mapped_vector<int> vec(mPath);
+        vec.resize(10);
+        vec[9] = 7;
+        vec.resize(2);
+        vec.resize(4);
+        EXPECT_THAT(vec, ElementsAre(0, 0, 0, 0));
+        vec.pop_back();
+        EXPECT_EQ(vec.size(), 3);
+        vec.clear();
+        EXPECT_TRUE(vec.empty());
+    }
+    EXPECT_EQ(FileSize(), 0);
+}
+
+TEST_F(MappedVectorTest, ReadOnly) {
+    EXPECT_THROW(container::mapped_vector<int>(mPath,
+                                               container::map_mode::read_only),
+                 std::system_error);
+    container::mapped_vector<int>(mPath).push_back(5);
+
+    container::mapped_vector<int> vec(mPath, container::map_mode::read_only);
+    EXPECT_THAT(vec, ElementsAre(5));
+    EXPECT_THROW(vec.push_back(6), std::logic_error);
+    EXPECT_THROW(vec.flush(), std::logic_error);
+    EXPECT_EQ(vec.size(), 1);
+}
+
+TEST_F(MappedVectorTest, RejectsTruncatedRecords) {
+    FILE* file = fopen(mPath.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite("abc", 1, 3, file);
+    fclose(file);
+    EXPECT_THROW(container::mapped_vector<int>{mPath}, std::runtime_error);
+}
+
+TEST_F(MappedVectorTest, Move) {
+    container::mapped_vector<int> vec(mPath);
+    vec.push_back(1);
+    container::mapped_vector<int> moved(std::move(vec));
+    EXPECT_THAT(moved, ElementsAre(1));
+    EXPECT_TRUE(vec.empty());
+    vec = std::move(moved);
+    vec.push_back(2);
+    EXPECT_THAT(vec, ElementsAre(1, 2));
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,72 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/monotonic_arena.hpp>
+#include <new>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(MonotonicArenaTest, BumpAllocation) {
+    container::monotonic_arena arena;
+    auto* first = (char*)arena.allocate(10, 1);
+    auto* second = (char*)arena.allocate(10, 1);
+    EXPECT_EQ(second, first + 10);
+    EXPECT_EQ(arena.upstream_bytes(), 4096);
+}
+
+TEST(MonotonicArenaTest, Alignment) {
+    container::monotonic_arena arena;
+    arena.allocate(1, 1);
+    auto* aligned = arena.allocate(8, 64);
+    EXPECT_EQ((uintptr_t)aligned % 64, 0);
+}
+
+TEST(MonotonicArenaTest, GrowsAndReleases) {
+    container::monotonic_arena arena(64);
+    auto* small = arena.allocate(32, 8);
+    auto* large = arena.allocate(1000, 8);
+    EXPECT_TRUE(arena.owns(small));
+    EXPECT_TRUE(arena.owns(large));
+    EXPECT_GE(arena.upstream_bytes(), 1000);
+    arena.release();
+    EXPECT_EQ(arena.upstream_bytes(), 0);
+    EXPECT_FALSE(arena.owns(large));
+}
+
+TEST(MonotonicArenaTest, InitialBuffer) {
+    alignas(16) char buffer[128];
+    container::monotonic_arena arena(buffer, sizeof(buffer));
+    auto* inside = arena.allocate(100, 1);
+    EXPECT_EQ(inside, buffer);
+    EXPECT_EQ(arena.upstream_bytes(), 0);
+    auto* outside = arena.allocate(100, 1);
+    EXPECT_NE(outside, nullptr);
+    EXPECT_GT(arena.upstream_bytes(), 0);
+    arena.release();
+    EXPECT_EQ(arena.allocate(1, 1), buffer);
+}
+
+TEST(MonotonicArenaTest, Allocator) {
+    container::monotonic_arena arena, otherArena;
+    container::arena_allocator<int> alloc(arena);
+    container::arena_allocator<double> rebound(alloc);
+    EXPECT_EQ(alloc, rebound);
+    EXPECT_NE(alloc, container::arena_allocator<int>(otherArena));
+    int* ints = alloc.allocate(4);
+    EXPECT_TRUE(arena.owns(ints));
+    alloc.deallocate(ints, 4);
+}
+
+TEST(MonotonicArenaTest, HugeAllocationsFail) {
+    container::monotonic_arena arena;
+    arena.allocate(1, 1);
+    container::arena_allocator<double> alloc(arena);
+    EXPECT_THROW(alloc.allocate(SIZE_MAX / sizeof(double)), std::bad_alloc);
+    EXPECT_THROW(alloc.allocate(SIZE_MAX / sizeof(double) + 2),
+                 std::bad_array_new_length);
+    EXPECT_THROW(arena.allocate(SIZE_MAX - 8, 8), std::bad_alloc);
+    // the arena still serves ordinary requests
+    EXPECT_TRUE(arena.owns(alloc.allocate(4)));
+}
+}  // namespace cpp::common::test
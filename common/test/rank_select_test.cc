@@ -0,0 +1,59 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/rank_select.hpp>
+#include <random>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(RankSelectTest, MatchesScan) {
+    std::mt19937 generator(5);
+    for (size_t n : {0, 1, 64, 511, 512, 4096, 4097, 20000, 70000}) {
+        // empty, sparse, dense and full
+        for (unsigned density : {0, 1, 100, 999, 1000}) {
+            container::vector<bool> bits;
+            for (size_t i = 0; i < n; ++i) {
+                bits.push_back(generator() % 1000 < density);
+            }
+            container::rank_select_vector<> index(bits);
+            std::vector<size_t> ones;
+            for (size_t i = 0; i <= n; ++i) {
+                ASSERT_EQ(index.rank(i), ones.size()) << n << " " << i;
+                if (i < n && bits[i]) {
+                    ones.push_back(i);
+                }
+            }
+            EXPECT_EQ(index.count(), ones.size());
+            for (size_t k = 0; k < ones.size(); ++k) {
+                ASSERT_EQ(index.select(k), ones[k]) << n << " " << k;
+            }
+            EXPECT_EQ(index.select(ones.size()), index.npos);
+        }
+    }
+}
+
+TEST(RankSelectTest, RebuildsAfterChanges) {
+    container::rank_select_vector<> index(container::vector<bool>(10000));
+    EXPECT_EQ(index.count(), 0);
+    EXPECT_EQ(index.select(0), index.npos);
+    index.set(9000);
+    index.set(3);
+    EXPECT_EQ(index.rank(9000), 1);
+    EXPECT_EQ(index.rank(9001), 2);
+    EXPECT_EQ(index.rank0(9001), 8999);
+    EXPECT_EQ(index.select(1), 9000);
+    index.reset(3);
+    index.push_back(true);
+    EXPECT_EQ(index.select(0), 9000);
+    EXPECT_EQ(index.select(1), 10000);
+    index.resize(5000, true);
+    index.build();
+    EXPECT_EQ(index.count(), 0);
+    auto bits = std::move(index).extract();
+    EXPECT_EQ(bits.size(), 5000);
+    EXPECT_EQ(index.count(), 0);
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,175 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <container/mapped_vector.hpp>
+#include <container/roaring_bitmap.hpp>
+#include <filesystem>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+/*
+ * Values in a few chunks of different density: a sparse array chunk, a
+ * dense bitmap chunk, a chunk of long runs and one shared only now and
+ * then between two sets built with different seeds.
+ */
+std::set<uint32_t> RandomValues(unsigned seed) {
+    std::mt19937 generator(seed);
+    std::set<uint32_t> values;
+    for (int i = 0; i < 300; ++i) {
+        values.insert(generator() % 65536);
+    }
+    for (int i = 0; i < 30000; ++i) {
+        values.insert(0x10000 | generator() % 65536);
+    }
+    for (uint32_t start = 0; start < 65536; start += 4096) {
+        const uint32_t length = generator() % 2048;
+        for (uint32_t low = start; low < start + length; ++low) {
+            values.insert(0x20000 | low);
+        }
+    }
+    for (int i = 0; i < 10; ++i) {
+        values.insert(((seed % 3 + 3) << 16) | generator() % 65536);
+        values.insert(generator());
+    }
+    return values;
+}
+
+std::vector<uint32_t> Values(const container::roaring_bitmap& bitmap) {
+    return std::vector<uint32_t>(bitmap.begin(), bitmap.end());
+}
+}  // namespace
+
+TEST(RoaringBitmapTest, AddRemoveContains) {
+    container::roaring_bitmap bitmap{7, 0x30000, 3, 0xffffffff};
+    EXPECT_THAT(Values(bitmap), ElementsAre(3, 7, 0x30000, 0xffffffff));
+    EXPECT_FALSE(bitmap.add(7));
+    EXPECT_TRUE(bitmap.contains(0xffffffff));
+    EXPECT_FALSE(bitmap.contains(8));
+
+    // past 4096 values the chunk becomes a bitmap, and back
+    std::set<uint32_t> expected(bitmap.begin(), bitmap.end());
+    for (uint32_t low = 0; low < 10000; low += 2) {
+        EXPECT_EQ(bitmap.add(0x50000 | low),
+                  expected.insert(0x50000 | low).second);
+    }
+    EXPECT_EQ(bitmap.cardinality(), expected.size());
+    for (uint32_t low = 0; low < 10000; low += 3) {
+        EXPECT_EQ(bitmap.remove(0x50000 | low), expected.erase(0x50000 | low));
+    }
+    EXPECT_EQ(bitmap.cardinality(), expected.size());
+    EXPECT_TRUE(std::equal(bitmap.begin(), bitmap.end(), expected.begin(),
+                           expected.end()));
+    EXPECT_TRUE(bitmap.remove(0x30000));
+    EXPECT_FALSE(bitmap.remove(0x30000));
+    EXPECT_FALSE(bitmap.contains(0x30000));
+}
+
+TEST(RoaringBitmapTest, SetOperationsMatchStd) {
+    const auto lhsValues = RandomValues(1);
+    const auto rhsValues = RandomValues(2);
+    container::roaring_bitmap lhs(lhsValues.begin(), lhsValues.end());
+    container::roaring_bitmap rhs(rhsValues.begin(), rhsValues.end());
+    for (bool runs : {false, true}) {
+        if (runs) {
+            lhs.run_optimize();
+            EXPECT_EQ(Values(lhs),
+                      std::vector<uint32_t>(lhsValues.begin(),
+                                            lhsValues.end()));
+        }
+        std::vector<uint32_t> expected;
+        std::set_intersection(lhsValues.begin(), lhsValues.end(),
+                              rhsValues.begin(), rhsValues.end(),
+                              std::back_inserter(expected));
+        EXPECT_EQ(Values(lhs & rhs), expected);
+        EXPECT_EQ(Values(rhs & lhs), expected);
+        EXPECT_EQ((lhs & rhs).cardinality(), expected.size());
+        expected.clear();
+        std::set_union(lhsValues.begin(), lhsValues.end(), rhsValues.begin(),
+                       rhsValues.end(), std::back_inserter(expected));
+        EXPECT_EQ(Values(lhs | rhs), expected);
+        expected.clear();
+        std::set_symmetric_difference(lhsValues.begin(), lhsValues.end(),
+                                      rhsValues.begin(), rhsValues.end(),
+                                      std::back_inserter(expected));
+        EXPECT_EQ(Values(lhs ^ rhs), expected);
+        expected.clear();
+        std::set_difference(lhsValues.begin(), lhsValues.end(),
+                            rhsValues.begin(), rhsValues.end(),
+                            std::back_inserter(expected));
+        auto difference = lhs;
+        difference.andnot(rhs);
+        EXPECT_EQ(Values(difference), expected);
+        EXPECT_EQ(difference.cardinality(), expected.size());
+    }
+    EXPECT_TRUE((lhs ^ lhs).empty());
+    EXPECT_EQ(lhs | lhs, lhs);
+}
+
+TEST(RoaringBitmapTest, RunOptimize) {
+    container::roaring_bitmap bitmap;
+    for (uint32_t value = 1000; value < 200000; ++value) {
+        bitmap.add(value);
+    }
+    bitmap.add(300000);
+    const size_t before = bitmap.serialized_size();
+    bitmap.run_optimize();
+    EXPECT_LT(bitmap.serialized_size(), before / 100);
+    EXPECT_EQ(bitmap.cardinality(), 199001);
+    EXPECT_TRUE(bitmap.contains(1000));
+    EXPECT_TRUE(bitmap.contains(199999));
+    EXPECT_FALSE(bitmap.contains(999));
+    EXPECT_FALSE(bitmap.contains(200000));
+    EXPECT_EQ(*bitmap.begin(), 1000);
+    // changing a run chunk turns it back into a bitmap
+    EXPECT_TRUE(bitmap.remove(5000));
+    EXPECT_FALSE(bitmap.contains(5000));
+    EXPECT_TRUE(bitmap.contains(5001));
+    EXPECT_EQ(bitmap.cardinality(), 199000);
+}
+
+TEST(RoaringBitmapTest, SerializeAndMap) {
+    const auto values = RandomValues(3);
+    container::roaring_bitmap bitmap(values.begin(), values.end());
+    bitmap.run_optimize();
+    const std::string path =
+        (std::filesystem::temp_directory_path() /
+         ("roaring_bitmap_test." + std::to_string(getpid())))
+            .string();
+    {
+        container::mapped_vector<char> file(path);
+        file.resize(bitmap.serialized_size());
+        bitmap.serialize(file.data());
+    }
+    {
+        const container::mapped_vector<char> file(
+            path, container::map_mode::read_only);
+        container::roaring_view view(file.data(), file.size());
+        EXPECT_EQ(view.cardinality(), values.size());
+        EXPECT_TRUE(std::equal(view.begin(), view.end(), values.begin(),
+                               values.end()));
+        for (uint32_t value : {0u, 0x10001u, 0x20005u, 0x7fffffffu}) {
+            EXPECT_EQ(view.contains(value), values.count(value) > 0);
+        }
+        EXPECT_EQ(container::roaring_bitmap(view), bitmap);
+        EXPECT_THROW(container::roaring_view(file.data(), 8),
+                     std::runtime_error);
+    }
+    std::filesystem::remove(path);
+
+    container::roaring_bitmap empty;
+    std::vector<uint64_t> words(empty.serialized_size() / 8);
+    empty.serialize(words.data());
+    EXPECT_TRUE(container::roaring_view(words.data(), 8).empty());
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,117 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/segmented_vector.hpp>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace cpp::common::test {
+using namespace testing;
+
+TEST(SegmentedVectorTest, ReferencesSurviveGrowth) {
+    container::segmented_vector<std::string, 4> vec;
+    vec.push_back("first");
+    std::string* first = &vec.front();
+    auto it = vec.begin();
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(first, &vec.front());
+    EXPECT_EQ(*it, "first");
+    EXPECT_EQ(vec.size(), 101);
+    EXPECT_EQ(vec.capacity(), 104);
+    EXPECT_EQ(vec.back(), "99");
+}
+
+TEST(SegmentedVectorTest, Segments) {
+    container::segmented_vector<int, 4> vec(10);
+    std::iota(vec.begin(), vec.end(), 0);
+    ASSERT_EQ(vec.segment_count(), 3);
+    EXPECT_THAT(vec.segment(0), ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(vec.segment(1), ElementsAre(4, 5, 6, 7));
+    EXPECT_THAT(vec.segment(2), ElementsAre(8, 9));
+    int sum = 0;
+    for (size_t i = 0; i < vec.segment_count(); ++i) {
+        for (int value : vec.segment(i)) {
+            sum += value;
+        }
+    }
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(SegmentedVectorTest, ShrinkToFitKeepsUsedSegments) {
+    container::segmented_vector<int, 4> vec;
+    vec.reserve(20);
+    EXPECT_EQ(vec.capacity(), 20);
+    vec.assign({1, 2, 3, 4, 5});
+    int* fifth = &vec[4];
+    vec.clear();
+    EXPECT_EQ(vec.capacity(), 20);
+    vec.assign({1, 2, 3, 4, 5});
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 8);
+    EXPECT_EQ(fifth, &vec[4]);
+    EXPECT_THAT(vec, ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(SegmentedVectorTest, InsertAndEraseAcrossSegments) {
+    container::segmented_vector<std::unique_ptr<int>, 2> vec;
+    for (int i = 0; i < 5; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+    vec.insert(vec.begin() + 1, std::make_unique<int>(9));
+    vec.erase(vec.begin() + 3, vec.begin() + 5);
+    std::vector<int> values;
+    for (const auto& p : vec) {
+        values.push_back(*p);
+    }
+    EXPECT_THAT(values, ElementsAre(0, 9, 1, 4));
+}
+
+TEST(SegmentedVectorTest, CopyAndMove) {
+    container::segmented_vector<std::string, 2> vec{"a", "b", "c"};
+    container::segmented_vector<std::string, 2> copy(vec);
+    EXPECT_EQ(copy, vec);
+    const std::string* b = &vec[1];
+    container::segmented_vector<std::string, 2> moved(std::move(vec));
+    EXPECT_EQ(b, &moved[1]);
+    EXPECT_TRUE(vec.empty());
+    copy = {"x"};
+    copy = moved;
+    EXPECT_EQ(copy, moved);
+    container::segmented_vector<std::string, 2> smaller{"a", "a"};
+    EXPECT_LT(smaller, copy);
+}
+
+namespace {
+// Ordered with operator< only.
+struct Version {
+    int number;
+    friend bool operator==(const Version&, const Version&) = default;
+    friend bool operator<(const Version& lhs, const Version& rhs) {
+        return lhs.number < rhs.number;
+    }
+};
+}  // namespace
+}  // namespace cpp::common::test
+
+template <>
+struct cpp::common::container::is_bitwise_comparable<
+    cpp::common::test::Version> : std::true_type {};
+
+namespace cpp::common::test {
+
+TEST(SegmentedVectorTest, BitwiseComparableWithoutThreeWay) {
+    container::segmented_vector<Version, 4> lhs, rhs;
+    for (int i = 0; i < 10; ++i) {
+        lhs.push_back({i});
+        rhs.push_back({i});
+    }
+    EXPECT_EQ(lhs <=> rhs, std::weak_ordering::equivalent);
+    rhs[9].number = 10;
+    EXPECT_EQ(lhs <=> rhs, std::weak_ordering::less);
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,88 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/monotonic_arena.hpp>
+#include <container/small_vector.hpp>
+#include <memory>
+#include <string>
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+template <typename Vector>
+bool IsInline(const Vector& vec) {
+    auto* data = (const char*)vec.data();
+    return data >= (const char*)&vec && data < (const char*)(&vec + 1);
+}
+}  // namespace
+
+TEST(SmallVectorTest, SpillsToHeapBeyondN) {
+    container::monotonic_arena arena;
+    container::small_vector<int, 4, container::arena_allocator<int>> vec(
+        arena);
+    EXPECT_EQ(vec.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_TRUE(IsInline(vec));
+    EXPECT_EQ(arena.upstream_bytes(), 0);
+
+    vec.push_back(4);
+    EXPECT_FALSE(IsInline(vec));
+    EXPECT_TRUE(arena.owns(vec.data()));
+    EXPECT_GT(vec.capacity(), 4);
+    EXPECT_THAT(vec, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(SmallVectorTest, ShrinkToFitReturnsInline) {
+    container::small_vector<std::string, 2> vec(5, std::string(64, 'x'));
+    EXPECT_FALSE(IsInline(vec));
+    vec.resize(2);
+    vec.shrink_to_fit();
+    EXPECT_TRUE(IsInline(vec));
+    EXPECT_EQ(vec.capacity(), 2);
+    EXPECT_THAT(vec, ElementsAre(std::string(64, 'x'), std::string(64, 'x')));
+}
+
+TEST(SmallVectorTest, CopyStaysInline) {
+    container::small_vector<int, 4> vec{1, 2, 3, 4, 5};
+    vec.pop_back();
+    container::small_vector<int, 4> copy(vec);
+    EXPECT_TRUE(IsInline(copy));
+    EXPECT_EQ(copy, vec);
+}
+
+TEST(SmallVectorTest, MoveInline) {
+    container::small_vector<std::unique_ptr<int>, 2> vec;
+    vec.push_back(std::make_unique<int>(1));
+    container::small_vector<std::unique_ptr<int>, 2> moved(std::move(vec));
+    EXPECT_TRUE(IsInline(moved));
+    EXPECT_EQ(*moved[0], 1);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 2);
+
+    vec = std::move(moved);
+    EXPECT_EQ(*vec[0], 1);
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(SmallVectorTest, MoveFromHeapStealsBuffer) {
+    container::small_vector<int, 2> vec{1, 2, 3};
+    const int* data = vec.data();
+    container::small_vector<int, 2> moved(std::move(vec));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(IsInline(vec));
+    EXPECT_EQ(vec.capacity(), 2);
+}
+
+TEST(SmallVectorTest, SwapInlineWithHeap) {
+    container::small_vector<std::string, 2> small{"a"};
+    container::small_vector<std::string, 2> large{"b", "c", "d"};
+    small.swap(large);
+    EXPECT_THAT(small, ElementsAre("b", "c", "d"));
+    EXPECT_THAT(large, ElementsAre("a"));
+    EXPECT_TRUE(IsInline(large));
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,86 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <container/soa_vector.hpp>
+#include <numeric>
+#include <string>
+
+namespace cpp::common::test {
+namespace {
+
+struct Order {
+    long id = 0;
+    double price = 0;
+    std::string customer;
+};
+
+}  // namespace
+}  // namespace cpp::common::test
+
+namespace cpp::common::reflection {
+template <>
+struct ObjectDef<test::Order> {
+    ObjectDef() = delete;
+    struct Name {
+        static constexpr std::string_view View = "Order";
+    };
+    struct id {
+        static constexpr std::string_view View = "id";
+    };
+    struct price {
+        static constexpr std::string_view View = "price";
+    };
+    struct customer {
+        static constexpr std::string_view View = "customer";
+    };
+    static constexpr ElemList Properties = {
+        Property{id{}, &test::Order::id},
+        Property{price{}, &test::Order::price},
+        Property{customer{}, &test::Order::customer}};
+};
+}  // namespace cpp::common::reflection
+
+namespace cpp::common::test {
+using namespace testing;
+
+namespace {
+typedef reflection::ObjectDef<Order> OrderDef;
+}  // namespace
+
+TEST(SoaVectorTest, ColumnsHoldOneFieldEach) {
+    container::soa_vector<Order> orders;
+    orders.push_back({1, 9.5, "ann"});
+    orders.push_back(Order{2, 0.5, "bob"});
+    ASSERT_EQ(orders.size(), 2);
+    EXPECT_THAT(orders.column<OrderDef::id>(), ElementsAre(1, 2));
+    EXPECT_THAT(orders.column<OrderDef::customer>(),
+                ElementsAre("ann", "bob"));
+    auto prices = orders.column<OrderDef::price>();
+    EXPECT_EQ(std::accumulate(prices.begin(), prices.end(), 0.0), 10.0);
+    static_assert(std::is_same_v<decltype(prices), std::span<double>>);
+}
+
+TEST(SoaVectorTest, RowProxies) {
+    container::soa_vector<Order> orders;
+    orders.resize(2);
+    orders[1] = Order{7, 1.25, "eve"};
+    EXPECT_EQ(orders[1].GetProperty<OrderDef::id>(), 7);
+    orders[0].SetProperty<OrderDef::customer>("joe");
+    orders.back().GetProperty<OrderDef::price>() *= 2;
+
+    const auto& view = orders;
+    Order row(view[1]);
+    EXPECT_EQ(row.id, 7);
+    EXPECT_EQ(row.price, 2.5);
+    EXPECT_EQ(row.customer, "eve");
+    EXPECT_EQ(view.front().GetProperty<OrderDef::customer>(), "joe");
+    EXPECT_THROW(view.at(2), std::out_of_range);
+
+    orders.pop_back();
+    EXPECT_EQ(orders.size(), 1);
+    EXPECT_EQ(orders.column<OrderDef::price>().size(), 1);
+    orders.clear();
+    EXPECT_TRUE(orders.empty());
+}
+
+}  // namespace cpp::common::test
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <container/thread_pool.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace cpp::common::test {
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    container::thread_pool pool(4);
+    EXPECT_EQ(pool.concurrency(), 4);
+    std::vector<std::atomic<int>> visits(1000);
+    for (int round = 0; round < 10; ++round) {
+        pool.parallel_for(visits.size(), [&](size_t i) { ++visits[i]; });
+    }
+    for (auto& count : visits) {
+        EXPECT_EQ(count, 10);
+    }
+    pool.parallel_for(0, [](size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, ExceptionIsRethrownAfterAllCalls) {
+    container::thread_pool pool(3);
+    std::atomic<int> calls = 0;
+    EXPECT_THROW(pool.parallel_for(100,
+                                   [&](size_t i) {
+                                       ++calls;
+                                       if (i % 10 == 0) {
+                                           throw std::runtime_error("odd");
+                                       }
+                                   }),
+                 std::runtime_error);
+    EXPECT_EQ(calls, 100);
+}
+
+TEST(ThreadPoolTest, SingleThreadRunsInline) {
+    container::thread_pool pool(1);
+    std::vector<size_t> order;
+    pool.parallel_for(3, [&](size_t i) { order.push_back(i); });
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2}));
+}
+
+}  // namespace cpp::common::test
@@ -1,7 +1,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <container/bvector.hpp>
+#include <container/monotonic_arena.hpp>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
 namespace cpp::common::test {
@@ -86,4 +90,268 @@ TYPED_TEST(VectorBoolTest, PopBack) {
         EXPECT_FALSE(i);
     }
 }
+
+TYPED_TEST(VectorBoolTest, ResizeWithValue) {
+    TypeParam vec(3);
+    vec.resize(130, true);
+    EXPECT_FALSE(vec[2]);
+    EXPECT_TRUE(vec[3]);
+    EXPECT_TRUE(vec[129]);
+    vec.resize(70);
+    vec.resize(140);
+    EXPECT_TRUE(vec[69]);
+    EXPECT_FALSE(vec[70]);
+    EXPECT_FALSE(vec[129]);
+}
+
+TEST(VectorBoolIteratorTest, Arithmetic) {
+    container::vector<bool> vec(200);
+    vec[0] = vec[63] = vec[64] = vec[199] = true;
+    auto it = vec.begin() + 64;
+    EXPECT_TRUE(*it);
+    EXPECT_TRUE(*--it);
+    EXPECT_FALSE(*--it);
+    EXPECT_TRUE(it[-62]);
+    EXPECT_TRUE(*(vec.end() - 1));
+    EXPECT_EQ(vec.end() - vec.begin(), 200);
+    EXPECT_EQ((vec.end() - 137) - vec.begin(), 63);
+    container::vector<bool>::const_iterator cit = it;
+    EXPECT_EQ(cit, vec.cbegin() + 62);
+    EXPECT_LT(cit, vec.cend());
+    size_t set = 0;
+    for (bool bit : vec) {
+        set += bit;
+    }
+    EXPECT_EQ(set, 4);
+}
+
+namespace {
+container::vector<bool> RandomBits(size_t n, std::mt19937& gen) {
+    container::vector<bool> bits;
+    for (size_t i = 0; i < n; ++i) {
+        bits.push_back(gen() & 1);
+    }
+    return bits;
+}
+}  // namespace
+
+TEST(VectorBoolBitwiseTest, MatchesPerBit) {
+    std::mt19937 gen(42);
+    for (size_t n : {0, 1, 63, 64, 65, 127, 128, 300, 1000}) {
+        const auto lhs = RandomBits(n, gen);
+        const auto rhs = RandomBits(n, gen);
+        container::vector<bool> both(n), either(n), one(n), only(n), inv(n);
+        for (size_t i = 0; i < n; ++i) {
+            both[i] = lhs[i] && rhs[i];
+            either[i] = lhs[i] || rhs[i];
+            one[i] = lhs[i] != rhs[i];
+            only[i] = lhs[i] && !rhs[i];
+            inv[i] = !lhs[i];
+        }
+        EXPECT_EQ(lhs & rhs, both);
+        EXPECT_EQ(lhs | rhs, either);
+        EXPECT_EQ(lhs ^ rhs, one);
+        EXPECT_EQ(container::vector<bool>(lhs).andnot(rhs), only);
+        // compares the words, so the bits past the size must stay clear
+        EXPECT_EQ(~lhs, inv);
+        EXPECT_EQ(~~lhs, lhs);
+    }
+}
+
+TEST(VectorBoolBitwiseTest, Shifts) {
+    std::mt19937 gen(7);
+    const auto bits = RandomBits(300, gen);
+    for (size_t n : {0, 1, 5, 63, 64, 65, 128, 200, 299, 300, 400}) {
+        container::vector<bool> up(300), down(300);
+        for (size_t i = 0; i < 300; ++i) {
+            up[i] = i >= n && bits[i - n];
+            down[i] = i + n < 300 && bits[i + n];
+        }
+        EXPECT_EQ(bits << n, up) << n;
+        EXPECT_EQ(bits >> n, down) << n;
+    }
+}
+
+TEST(VectorBoolBitwiseTest, ComparesLikeStd) {
+    std::mt19937 gen(3);
+    for (int round = 0; round < 100; ++round) {
+        auto lhs = RandomBits(gen() % 150, gen);
+        auto rhs = RandomBits(gen() % 150, gen);
+        if (round % 2) {
+            rhs = lhs;
+            rhs.push_back(true);
+            rhs[gen() % rhs.size()].flip();
+        }
+        std::vector<bool> stdLhs(lhs.begin(), lhs.end());
+        std::vector<bool> stdRhs(rhs.begin(), rhs.end());
+        EXPECT_EQ(lhs <=> rhs, stdLhs <=> stdRhs);
+        EXPECT_EQ(lhs == rhs, stdLhs == stdRhs);
+    }
+}
+
+TEST(VectorBoolBitwiseTest, SizeMismatchThrows) {
+    container::vector<bool> lhs(10), rhs(11);
+    EXPECT_THROW(lhs &= rhs, std::invalid_argument);
+    EXPECT_THROW(lhs |= rhs, std::invalid_argument);
+    EXPECT_THROW(lhs ^= rhs, std::invalid_argument);
+    EXPECT_THROW(lhs.andnot(rhs), std::invalid_argument);
+}
+
+TEST(VectorBoolScanTest, MatchesPerBit) {
+    std::mt19937 gen(11);
+    for (size_t n : {0, 1, 63, 64, 65, 200, 1000}) {
+        // sparse, dense and random bits
+        for (unsigned density : {0, 1, 16, 31, 32}) {
+            container::vector<bool> bits;
+            for (size_t i = 0; i < n; ++i) {
+                bits.push_back(gen() % 32 < density);
+            }
+            size_t set = 0;
+            std::vector<size_t> ones, zeros;
+            for (size_t i = 0; i < n; ++i) {
+                set += bits[i];
+                (bits[i] ? ones : zeros).push_back(i);
+            }
+            EXPECT_EQ(bits.count(), set);
+            EXPECT_EQ(bits.any(), set > 0);
+            EXPECT_EQ(bits.none(), set == 0);
+            EXPECT_EQ(bits.all(), set == n);
+
+            std::vector<size_t> found;
+            for (size_t i = bits.find_first(); i != bits.npos;
+                 i = bits.find_next(i)) {
+                found.push_back(i);
+            }
+            EXPECT_EQ(found, ones);
+            found.clear();
+            for (size_t i = bits.find_first_unset(); i != bits.npos;
+                 i = bits.find_next_unset(i)) {
+                found.push_back(i);
+            }
+            EXPECT_EQ(found, zeros);
+        }
+    }
+}
+
+TEST(VectorBoolScanTest, IgnoresBitsPastSize) {
+    container::vector<bool> bits(70, true);
+    EXPECT_TRUE(bits.all());
+    EXPECT_EQ(bits.find_first_unset(), bits.npos);
+    bits.pop_back();
+    bits.push_back(false);
+    EXPECT_FALSE(bits.all());
+    EXPECT_EQ(bits.find_first_unset(), 69);
+    EXPECT_EQ(bits.find_next_unset(69), bits.npos);
+    EXPECT_EQ(bits.find_next(68), bits.npos);
+    bits.resize(64);
+    EXPECT_EQ(bits.count(), 64);
+    EXPECT_EQ(bits.find_first_unset(), bits.npos);
+}
+
+TEST(VectorBoolScanTest, FindNextAtTheEnd) {
+    container::vector<bool> bits(130);
+    bits[0] = bits[129] = true;
+    EXPECT_EQ(bits.find_next(0), 129);
+    EXPECT_EQ(bits.find_next(128), 129);
+    EXPECT_EQ(bits.find_next(129), bits.npos);
+    EXPECT_EQ(bits.find_next_unset(128), bits.npos);
+    EXPECT_EQ(bits.find_next_unset(129), bits.npos);
+    // a failed search fed back in stays failed instead of wrapping around
+    EXPECT_EQ(bits.find_next(bits.npos), bits.npos);
+    EXPECT_EQ(bits.find_next_unset(bits.npos), bits.npos);
+    container::vector<bool> empty;
+    EXPECT_EQ(empty.find_next(0), empty.npos);
+    EXPECT_EQ(empty.find_next(empty.npos), empty.npos);
+    EXPECT_EQ(empty.find_next_unset(empty.npos), empty.npos);
+}
+
+TEST(VectorBoolRangeTest, SetResetFlip) {
+    std::mt19937 gen(13);
+    const auto bits = RandomBits(300, gen);
+    for (auto [first, last] : {std::pair<size_t, size_t>{0, 0},
+                               {0, 300},
+                               {3, 9},
+                               {60, 70},
+                               {64, 128},
+                               {1, 299},
+                               {130, 300}}) {
+        auto set = bits, reset = bits, flipped = bits;
+        set.set(first, last);
+        reset.reset(first, last);
+        flipped.flip(first, last);
+        for (size_t i = 0; i < 300; ++i) {
+            const bool inside = i >= first && i < last;
+            ASSERT_EQ(set[i], inside || bits[i]) << first << " " << i;
+            ASSERT_EQ(reset[i], !inside && bits[i]) << first << " " << i;
+            ASSERT_EQ(flipped[i], inside != bits[i]) << first << " " << i;
+        }
+    }
+    container::vector<bool> vec(10);
+    EXPECT_THROW(vec.set(5, 11), std::out_of_range);
+    EXPECT_THROW(vec.flip(6, 5), std::out_of_range);
+}
+
+TEST(VectorBoolRangeTest, CopyBits) {
+    std::mt19937 gen(17);
+    const auto src = RandomBits(400, gen);
+    const auto dst = RandomBits(400, gen);
+    for (size_t src_pos : {0, 5, 64, 100}) {
+        for (size_t dst_pos : {0, 3, 64, 101}) {
+            for (size_t n : {0, 1, 50, 64, 130, 290}) {
+                // from another vector
+                auto copy = dst;
+                copy.copy_bits(src, src_pos, dst_pos, n);
+                // within the vector, so the ranges overlap
+                auto moved = src;
+                moved.copy_bits(moved, src_pos, dst_pos, n);
+                for (size_t i = 0; i < 400; ++i) {
+                    const bool inside = i >= dst_pos && i < dst_pos + n;
+                    const size_t from = src_pos + i - dst_pos;
+                    ASSERT_EQ(copy[i], inside ? src[from] : dst[i])
+                        << src_pos << " " << dst_pos << " " << n;
+                    ASSERT_EQ(moved[i], inside ? src[from] : src[i])
+                        << src_pos << " " << dst_pos << " " << n;
+                }
+            }
+        }
+    }
+    container::vector<bool> vec(10);
+    EXPECT_THROW(vec.copy_bits(vec, 5, 0, 6), std::out_of_range);
+}
+
+TEST(VectorBoolRangeTest, StdAlgorithms) {
+    std::mt19937 gen(19);
+    const auto bits = RandomBits(500, gen);
+    container::vector<bool> vec(500);
+    std::fill(vec.begin() + 10, vec.end() - 10, true);
+    EXPECT_EQ(vec.count(), 480);
+    EXPECT_FALSE(vec[9]);
+    EXPECT_TRUE(vec[10]);
+    EXPECT_TRUE(vec[489]);
+    EXPECT_FALSE(vec[490]);
+
+    auto out =
+        std::copy(bits.begin() + 7, bits.begin() + 407, vec.begin() + 33);
+    EXPECT_EQ(out - vec.begin(), 433);
+    EXPECT_TRUE(std::equal(vec.begin() + 33, out, bits.begin() + 7));
+    EXPECT_TRUE(std::equal(vec.cbegin() + 33, vec.cbegin() + 433,
+                           bits.begin() + 7, bits.begin() + 407));
+    EXPECT_FALSE(std::equal(vec.begin() + 33, out, bits.begin() + 8));
+    EXPECT_TRUE(vec[32]);
+    EXPECT_TRUE(vec[433]);
+}
+
+TEST(VectorBoolAllocatorTest, ArenaBacked) {
+    container::monotonic_arena arena;
+    container::vector<bool, container::arena_allocator<bool>> vec(arena);
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i % 3 == 0);
+    }
+    EXPECT_TRUE(arena.owns(&vec.front().mbit_type[0]));
+    auto copy = vec;
+    EXPECT_EQ(copy.get_allocator().arena(), &arena);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(copy[i], i % 3 == 0);
+    }
+}
 }  // namespace cpp::common::test
\ No newline at end of file
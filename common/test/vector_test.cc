@@ -1,7 +1,24 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <string.h>
 
+#include <container/cache_padded.hpp>
+#include <container/monotonic_arena.hpp>
+#include <container/segmented_vector.hpp>
+#include <container/small_vector.hpp>
 #include <container/vector.hpp>
+#include <container/vector_parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <compare>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace cpp::common::test {
@@ -65,7 +82,9 @@ class VectorTest : public Test {
 };
 
 using VectorTypes =
-    ::testing::Types<container::vector<TestObject>, std::vector<TestObject>>;
+    ::testing::Types<container::vector<TestObject>,
+                     container::small_vector<TestObject, 1>,
+                     std::vector<TestObject>>;
 
 TYPED_TEST_SUITE(VectorTest, VectorTypes);
 
@@ -73,7 +92,8 @@ template <typename T>
 class VectorIntTest : public Test {};
 
 using VectorIntTypes =
-    ::testing::Types<container::vector<int>, std::vector<int>>;
+    ::testing::Types<container::vector<int>, container::small_vector<int, 8>,
+                     container::segmented_vector<int, 4>, std::vector<int>>;
 
 TYPED_TEST_SUITE(VectorIntTest, VectorIntTypes);
 }  // namespace
@@ -337,6 +357,34 @@ TYPED_TEST(VectorTest, Swap) {
     }
 }
 
+TYPED_TEST(VectorTest, RangeInitAndAssign) {
+    {
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(3);
+        std::vector<TestObject> source;
+        source.reserve(3);
+        for (int i = 0; i < 3; ++i) {
+            source.emplace_back(i);
+        }
+
+        // exactly one copy per element, nothing is relocated
+        EXPECT_CALL(*stub, CopyConstructor()).Times(3);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(0);
+        TypeParam vec(source.begin(), source.end());
+        EXPECT_EQ(vec.size(), 3);
+        EXPECT_EQ(vec.capacity(), 3);
+        EXPECT_EQ(vec[2].mValue, 2);
+
+        // live elements are assigned to, the surplus is destroyed
+        EXPECT_CALL(*stub, Die()).Times(1);
+        EXPECT_CALL(*stub, CopyConstructor()).Times(0);
+        vec.assign(source.begin() + 1, source.end());
+        EXPECT_EQ(vec.size(), 2);
+        EXPECT_EQ(vec[0].mValue, 1);
+
+        EXPECT_CALL(*stub, Die()).Times(5);
+    }
+}
+
 TYPED_TEST(VectorTest, TraverseIterator) {
     {
         EXPECT_CALL(*stub, IntParamConstructor()).Times(1);
@@ -350,6 +398,131 @@ TYPED_TEST(VectorTest, TraverseIterator) {
     }
 }
 
+TYPED_TEST(VectorTest, EmplaceBack) {
+    {
+        TypeParam vec;
+        vec.reserve(2);
+        EXPECT_CALL(*stub, CopyConstructor()).Times(0);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(0);
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(1);
+        EXPECT_CALL(*stub, NoParamConstructor()).Times(1);
+        EXPECT_EQ(vec.emplace_back(3).mValue, 3);
+        vec.emplace_back();
+        EXPECT_EQ(vec.size(), 2);
+        EXPECT_EQ(vec[0].mValue, 3);
+        EXPECT_EQ(vec[1].mValue, 0);
+
+        EXPECT_CALL(*stub, Die()).Times(2);
+    }
+}
+
+TYPED_TEST(VectorTest, Emplace) {
+    {
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(3);
+        TypeParam vec;
+        vec.reserve(4);
+        vec.emplace_back(1);
+        vec.emplace_back(2);
+
+        // at the end the element is constructed in place
+        EXPECT_CALL(*stub, CopyConstructor()).Times(0);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(0);
+        auto it = vec.emplace(vec.end(), 3);
+        EXPECT_EQ(it->mValue, 3);
+
+        // in the middle only the last element is move constructed
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(1);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(1);
+        EXPECT_CALL(*stub, Die()).Times(1);
+        it = vec.emplace(vec.begin(), 0);
+        EXPECT_EQ(it->mValue, 0);
+        EXPECT_EQ(vec.size(), 4);
+        for (size_t i = 0; i < vec.size(); ++i) {
+            EXPECT_EQ(vec[i].mValue, i);
+        }
+
+        EXPECT_CALL(*stub, Die()).Times(4);
+    }
+}
+
+TYPED_TEST(VectorTest, InsertRange) {
+    {
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(6);
+        std::vector<TestObject> source;
+        source.reserve(2);
+        source.emplace_back(10);
+        source.emplace_back(11);
+        TypeParam vec;
+        vec.reserve(8);
+        for (int i = 0; i < 4; ++i) {
+            vec.emplace_back(i);
+        }
+
+        // the shifted tail is move constructed, the source is assigned
+        EXPECT_CALL(*stub, CopyConstructor()).Times(0);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(2);
+        auto it = vec.insert(vec.begin() + 1, source.begin(), source.end());
+        EXPECT_EQ(it->mValue, 10);
+        EXPECT_EQ(vec.size(), 6);
+        EXPECT_EQ(vec.capacity(), 8);
+        std::vector<int> expected{0, 10, 11, 1, 2, 3};
+        for (size_t i = 0; i < vec.size(); ++i) {
+            EXPECT_EQ(vec[i].mValue, expected[i]);
+        }
+
+        EXPECT_CALL(*stub, Die()).Times(8);
+    }
+}
+
+TYPED_TEST(VectorTest, InsertRangeReallocates) {
+    {
+        EXPECT_CALL(*stub, IntParamConstructor()).Times(3);
+        std::vector<TestObject> source;
+        source.reserve(3);
+        for (int i = 0; i < 3; ++i) {
+            source.emplace_back(i);
+        }
+        EXPECT_CALL(*stub, NoParamConstructor()).Times(2);
+        TypeParam vec(2);
+
+        // one copy per inserted element plus one per relocated element
+        // (the move constructor of TestObject may throw)
+        EXPECT_CALL(*stub, CopyConstructor()).Times(5);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(0);
+        EXPECT_CALL(*stub, Die()).Times(2);
+        vec.insert(vec.begin() + 1, source.begin(), source.end());
+        EXPECT_EQ(vec.size(), 5);
+        EXPECT_GE(vec.capacity(), 5);
+
+        EXPECT_CALL(*stub, Die()).Times(8);
+    }
+}
+
+TYPED_TEST(VectorTest, Erase) {
+    {
+        EXPECT_CALL(*stub, NoParamConstructor()).Times(5);
+        TypeParam vec(5);
+        for (size_t i = 0; i < vec.size(); ++i) {
+            vec[i].mValue = i;
+        }
+
+        EXPECT_CALL(*stub, CopyConstructor()).Times(0);
+        EXPECT_CALL(*stub, MoveConstructor()).Times(0);
+        EXPECT_CALL(*stub, Die()).Times(1);
+        auto it = vec.erase(vec.begin());
+        EXPECT_EQ(it->mValue, 1);
+
+        EXPECT_CALL(*stub, Die()).Times(2);
+        it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+        EXPECT_EQ(it->mValue, 4);
+        EXPECT_EQ(vec.size(), 2);
+        EXPECT_EQ(vec[0].mValue, 1);
+        EXPECT_EQ(vec[1].mValue, 4);
+
+        EXPECT_CALL(*stub, Die()).Times(2);
+    }
+}
+
 TYPED_TEST(VectorIntTest, IteratorDereferencePlus) {
     TypeParam vec(5, 1);
     auto iter = vec.begin();
@@ -376,4 +549,518 @@ TYPED_TEST(VectorIntTest, IteratorSort) {
     std::sort(vec.begin(), vec.end());
     EXPECT_THAT(vec, ElementsAre(1, 2, 3, 4, 5));
 }
-}  // namespace cpp::common::test
\ No newline at end of file
+TYPED_TEST(VectorIntTest, Insert) {
+    TypeParam vec{1, 2, 3};
+    vec.insert(vec.begin() + 1, 7);
+    EXPECT_THAT(vec, ElementsAre(1, 7, 2, 3));
+    vec.insert(vec.end(), 2, 9);
+    EXPECT_THAT(vec, ElementsAre(1, 7, 2, 3, 9, 9));
+    vec.insert(vec.begin(), {4, 5});
+    EXPECT_THAT(vec, ElementsAre(4, 5, 1, 7, 2, 3, 9, 9));
+    std::vector<int> source{6, 6, 6};
+    vec.insert(vec.begin() + 3, source.begin(), source.end());
+    EXPECT_THAT(vec, ElementsAre(4, 5, 1, 6, 6, 6, 7, 2, 3, 9, 9));
+}
+
+TYPED_TEST(VectorIntTest, InsertAliasing) {
+    TypeParam vec{1, 2, 3};
+    vec.reserve(16);
+    vec.insert(vec.begin(), vec[2]);
+    EXPECT_THAT(vec, ElementsAre(3, 1, 2, 3));
+    vec.insert(vec.begin(), 2, vec.back());
+    EXPECT_THAT(vec, ElementsAre(3, 3, 3, 1, 2, 3));
+    vec.shrink_to_fit();
+    vec.emplace(vec.begin() + 1, vec[3]);
+    EXPECT_THAT(vec, ElementsAre(3, 1, 3, 3, 1, 2, 3));
+    vec.shrink_to_fit();
+    vec.emplace_back(vec[1]);
+    EXPECT_THAT(vec, ElementsAre(3, 1, 3, 3, 1, 2, 3, 1));
+}
+
+TEST(VectorAliasingTest, ResizeFromOwnElement) {
+    const std::string value(64, 'x');
+    container::vector<std::string> vec{value, "y"};
+    vec.shrink_to_fit();
+    vec.resize(4, vec[0]);
+    EXPECT_THAT(vec, ElementsAre(value, "y", value, value));
+}
+
+TYPED_TEST(VectorIntTest, Erase) {
+    TypeParam vec{1, 2, 3, 4, 5, 6};
+    auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+    EXPECT_EQ(*it, 4);
+    EXPECT_THAT(vec, ElementsAre(1, 4, 5, 6));
+    it = vec.erase(vec.end() - 1);
+    EXPECT_EQ(it, vec.end());
+    EXPECT_THAT(vec, ElementsAre(1, 4, 5));
+    vec.erase(vec.begin(), vec.begin());
+    EXPECT_THAT(vec, ElementsAre(1, 4, 5));
+}
+
+TYPED_TEST(VectorIntTest, RangeInit) {
+    std::list<int> list{1, 2, 3};
+    TypeParam fromList(list.begin(), list.end());
+    EXPECT_THAT(fromList, ElementsAre(1, 2, 3));
+
+    std::istringstream stream("4 5 6 7");
+    TypeParam fromStream(std::istream_iterator<int>(stream),
+                         std::istream_iterator<int>{});
+    EXPECT_THAT(fromStream, ElementsAre(4, 5, 6, 7));
+
+    TypeParam fromVector(fromStream.begin(), fromStream.end());
+    EXPECT_EQ(fromVector, fromStream);
+}
+
+TYPED_TEST(VectorIntTest, AssignRange) {
+    TypeParam vec{1, 2, 3};
+    int array[] = {7, 8, 9, 10, 11};
+    vec.assign(array, array + 5);
+    EXPECT_THAT(vec, ElementsAre(7, 8, 9, 10, 11));
+    vec.assign({4});
+    EXPECT_THAT(vec, ElementsAre(4));
+    std::istringstream stream("1 2");
+    vec.assign(std::istream_iterator<int>(stream),
+               std::istream_iterator<int>{});
+    EXPECT_THAT(vec, ElementsAre(1, 2));
+}
+
+TYPED_TEST(VectorIntTest, Compare) {
+    TypeParam vec{1, 2, 3}, same{1, 2, 3}, larger{1, 3}, prefix{1, 2};
+    EXPECT_TRUE(vec == same);
+    EXPECT_FALSE(vec != same);
+    EXPECT_TRUE(vec < larger);
+    EXPECT_TRUE(prefix < vec);
+    EXPECT_TRUE(vec <= same);
+    EXPECT_TRUE(larger > vec);
+    EXPECT_EQ(vec <=> same, std::strong_ordering::equal);
+    EXPECT_EQ(vec <=> larger, std::strong_ordering::less);
+    EXPECT_EQ(vec <=> prefix, std::strong_ordering::greater);
+    EXPECT_EQ(TypeParam() <=> TypeParam(), std::strong_ordering::equal);
+}
+
+TEST(VectorRangeTest, Append) {
+    container::vector<int> vec{1};
+    std::vector<int> source{2, 3, 4};
+    vec.append(source.begin(), source.end());
+    EXPECT_THAT(vec, ElementsAre(1, 2, 3, 4));
+    vec.append({5, 6});
+    EXPECT_THAT(vec, ElementsAre(1, 2, 3, 4, 5, 6));
+    std::istringstream stream("7 8");
+    vec.append(std::istream_iterator<int>(stream),
+               std::istream_iterator<int>{});
+    EXPECT_THAT(vec, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8));
+}
+
+TEST(VectorRangeTest, ContiguousIterators) {
+    typedef container::vector<int> Ints;
+    static_assert(std::contiguous_iterator<Ints::iterator>);
+    static_assert(std::contiguous_iterator<Ints::const_iterator>);
+    static_assert(std::ranges::contiguous_range<const Ints>);
+
+    Ints vec{1, 2, 3, 4};
+    EXPECT_EQ(std::to_address(vec.begin()), vec.data());
+    EXPECT_EQ(std::to_address(vec.cend()), vec.data() + vec.size());
+    Ints::const_iterator it = 2 + vec.begin();
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it[-1], 2);
+    EXPECT_EQ(vec.end() - it, 2);
+    EXPECT_TRUE(vec.begin() < it);
+    EXPECT_EQ(it <=> vec.cbegin() + 2, std::strong_ordering::equal);
+
+    std::span<int> span = vec;
+    span[0] = 5;
+    const Ints& cvec = vec;
+    std::span<const int> cspan = cvec;
+    EXPECT_THAT(cspan, ElementsAre(5, 2, 3, 4));
+    Ints copy(vec.size());
+    std::ranges::copy(vec, copy.begin());
+    EXPECT_EQ(copy, vec);
+
+    // iterators of different containers do not mix
+    static_assert(!std::is_same_v<Ints::iterator,
+                                  container::vector<long>::iterator>);
+    static_assert(!std::is_same_v<Ints::iterator, std::vector<int>::iterator>);
+    Ints::iterator first = vec.begin(), last = vec.end() - 1;
+    swap(first, last);
+    EXPECT_EQ(*first, 4);
+    EXPECT_EQ(*last, 5);
+
+    // assigning over live elements goes through the unwrapped pointers
+    Ints assigned{9, 9, 9, 9, 9};
+    assigned.assign(vec.cbegin() + 1, vec.cend());
+    EXPECT_THAT(assigned, ElementsAre(2, 3, 4));
+    assigned.assign(vec.begin(), vec.end());
+    EXPECT_EQ(assigned, vec);
+}
+
+TEST(VectorRangeTest, PortablePointerIterator) {
+    // the iterator class used where the library does not unwrap its own
+    typedef container::vector<int> Ints;
+    typedef container::detail::basic_pointer_iterator<Ints, int> Iterator;
+    typedef container::detail::basic_pointer_iterator<Ints, const int>
+        ConstIterator;
+    static_assert(std::contiguous_iterator<Iterator>);
+    static_assert(std::contiguous_iterator<ConstIterator>);
+    static_assert(std::is_convertible_v<Iterator, ConstIterator>);
+    static_assert(!std::is_convertible_v<ConstIterator, Iterator>);
+
+    int array[] = {1, 2, 3, 4};
+    Iterator first(array), last(array + 4);
+    ConstIterator it = first + 2;
+    EXPECT_EQ(std::to_address(it), array + 2);
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it[-1], 2);
+    EXPECT_EQ(last - it, 2);
+    EXPECT_EQ(it <=> ConstIterator(array + 2), std::strong_ordering::equal);
+    swap(first, last);
+    EXPECT_EQ(std::to_address(first), array + 4);
+    int copy[4];
+    std::copy(last, first, copy);
+    EXPECT_TRUE(std::equal(copy, copy + 4, ConstIterator(array)));
+}
+
+TEST(VectorRelocationTest, ReserveMovesNoexceptElements) {
+    container::vector<std::string> vec;
+    vec.push_back(std::string(64, 'x'));
+    const char* heapBuffer = vec[0].data();
+    vec.reserve(vec.capacity() * 4);
+    // a copy would have allocated a new heap buffer for the string
+    EXPECT_EQ(vec[0].data(), heapBuffer);
+    EXPECT_EQ(vec[0], std::string(64, 'x'));
+}
+
+TEST(VectorRelocationTest, ReserveMoveOnlyElements) {
+    container::vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 10; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+    vec.pop_back();
+    vec.shrink_to_fit();
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(*vec[i], i);
+    }
+}
+namespace {
+// A stateful allocator that follows its container on copy, move and swap.
+template <typename T>
+struct TaggedAllocator : container::malloc_allocator<T> {
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    template <typename U>
+    struct rebind {
+        typedef TaggedAllocator<U> other;
+    };
+
+    TaggedAllocator(int tag) : mTag(tag) {}
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U>& rhs) : mTag(rhs.mTag) {}
+    bool operator==(const TaggedAllocator& rhs) const {
+        return mTag == rhs.mTag;
+    }
+    int mTag;
+};
+}  // namespace
+
+TEST(VectorAllocatorTest, ArenaBacked) {
+    container::monotonic_arena arena, otherArena;
+    using ArenaVector =
+        container::vector<int, container::arena_allocator<int>>;
+    ArenaVector vec(arena);
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_TRUE(arena.owns(vec.data()));
+
+    ArenaVector copy(vec);
+    EXPECT_EQ(copy, vec);
+    EXPECT_TRUE(arena.owns(copy.data()));
+
+    // arena allocators do not propagate, so elements move between arenas
+    ArenaVector other(otherArena);
+    other = std::move(vec);
+    EXPECT_EQ(other, copy);
+    EXPECT_TRUE(otherArena.owns(other.data()));
+    EXPECT_EQ(other.get_allocator().arena(), &otherArena);
+}
+
+TEST(VectorAllocatorTest, Propagation) {
+    using TaggedVector = container::vector<int, TaggedAllocator<int>>;
+    TaggedVector vec1({1, 2, 3}, TaggedAllocator<int>(1));
+    TaggedVector vec2(TaggedAllocator<int>(2));
+
+    const int* buffer = vec1.data();
+    vec2 = std::move(vec1);
+    EXPECT_EQ(vec2.data(), buffer);
+    EXPECT_EQ(vec2.get_allocator().mTag, 1);
+
+    TaggedVector vec3(TaggedAllocator<int>(3));
+    vec3 = vec2;
+    EXPECT_EQ(vec3.get_allocator().mTag, 1);
+    EXPECT_THAT(vec3, ElementsAre(1, 2, 3));
+
+    TaggedVector vec4({4}, TaggedAllocator<int>(4));
+    vec4.swap(vec3);
+    EXPECT_EQ(vec4.get_allocator().mTag, 1);
+    EXPECT_EQ(vec3.get_allocator().mTag, 4);
+    EXPECT_THAT(vec3, ElementsAre(4));
+}
+
+TEST(VectorGrowthTest, PowerOfTwo) {
+    container::vector<int> vec;
+    std::vector<size_t> capacities;
+    for (int i = 0; i < 9; ++i) {
+        vec.push_back(i);
+        capacities.push_back(vec.capacity());
+    }
+    EXPECT_THAT(capacities, ElementsAre(1, 2, 4, 4, 8, 8, 8, 8, 16));
+}
+
+TEST(VectorGrowthTest, Geometric) {
+    container::vector<int, container::malloc_allocator<int>,
+                      container::geometric_growth<3, 2>>
+        vec;
+    vec.reserve(10);
+    EXPECT_EQ(vec.capacity(), 10);
+    vec.resize(11);
+    EXPECT_EQ(vec.capacity(), 15);
+    vec.resize(16);
+    EXPECT_EQ(vec.capacity(), 22);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(vec[i], 0);
+    }
+}
+
+TEST(VectorGrowthTest, SizeClass) {
+    using Growth = container::size_class_growth;
+    EXPECT_EQ(Growth::round_to_size_class(1), 16);
+    EXPECT_EQ(Growth::round_to_size_class(128), 128);
+    EXPECT_EQ(Growth::round_to_size_class(129), 160);
+    EXPECT_EQ(Growth::round_to_size_class(257), 320);
+    EXPECT_EQ(Growth::round_to_size_class(4096), 4096);
+    EXPECT_EQ(Growth::round_to_size_class(4097), 5120);
+
+    container::vector<int, container::malloc_allocator<int>, Growth> vec;
+    vec.push_back(1);
+    EXPECT_EQ(vec.capacity(), 4);
+    for (int i = 2; i <= 100; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.capacity() * sizeof(int),
+              Growth::round_to_size_class(vec.capacity() * sizeof(int)));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(vec[i], i + 1);
+    }
+}
+
+TEST(VectorBufferTest, DefaultInitResize) {
+    container::vector<char> buffer(4, container::default_init);
+    EXPECT_EQ(buffer.size(), 4);
+    memcpy(buffer.data(), "abcd", 4);
+    buffer.resize(8, container::default_init);
+    EXPECT_EQ(buffer.size(), 8);
+    EXPECT_EQ(memcmp(buffer.data(), "abcd", 4), 0);
+    buffer.resize(2, container::default_init);
+    EXPECT_THAT(buffer, ElementsAre('a', 'b'));
+
+    stub.reset(new Stub());
+    {
+        // class types still run their default constructor
+        EXPECT_CALL(*stub, NoParamConstructor()).Times(3);
+        container::vector<TestObject> objects;
+        objects.resize(3, container::default_init);
+        EXPECT_CALL(*stub, Die()).Times(3);
+    }
+    stub.reset();
+}
+
+TEST(VectorBufferTest, PrepareAndCommitAppend) {
+    container::vector<char> buffer{'>'};
+    char* tail = buffer.prepare_append(16);
+    EXPECT_EQ(tail, buffer.data() + 1);
+    EXPECT_GE(buffer.capacity(), 17);
+    EXPECT_EQ(buffer.size(), 1);
+    memcpy(tail, "hello", 5);
+    buffer.commit_append(5);
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), ">hello");
+
+    EXPECT_THROW(buffer.commit_append(buffer.capacity()), std::out_of_range);
+    EXPECT_EQ(buffer.size(), 6);
+}
+
+namespace {
+struct Point {
+    int x;
+    int y;
+    friend auto operator<=>(const Point&, const Point&) = default;
+};
+
+// Ordered with operator< only.
+struct Version {
+    int number;
+    friend bool operator==(const Version&, const Version&) = default;
+    friend bool operator<(const Version& lhs, const Version& rhs) {
+        return lhs.number < rhs.number;
+    }
+};
+}  // namespace
+}  // namespace cpp::common::test
+
+template <>
+struct cpp::common::container::is_bitwise_comparable<
+    cpp::common::test::Point> : std::true_type {};
+template <>
+struct cpp::common::container::is_bitwise_comparable<
+    cpp::common::test::Version> : std::true_type {};
+
+namespace cpp::common::test {
+
+TEST(VectorCompareTest, MismatchCrossesSimdBlocks) {
+    container::vector<int> lhs(100), rhs(100);
+    EXPECT_EQ(container::mismatch(lhs, rhs), 100);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        rhs[i] = -1;
+        EXPECT_EQ(container::mismatch(lhs, rhs), i);
+        EXPECT_NE(lhs, rhs);
+        EXPECT_GT(lhs, rhs);
+        rhs[i] = 0;
+    }
+    container::vector<char> shorter{'a', 'b'}, longer{'a', 'b', 'c'};
+    EXPECT_EQ(container::mismatch(shorter, longer), 2);
+    EXPECT_LT(shorter, longer);
+}
+
+TEST(VectorCompareTest, ElementwiseTypes) {
+    container::vector<double> zeros(9, 0.0), negativeZeros(9, -0.0);
+    EXPECT_EQ(zeros, negativeZeros);
+    container::vector<float> nan(9, std::nanf(""));
+    EXPECT_NE(nan, nan);
+    EXPECT_EQ(nan <=> nan, std::partial_ordering::unordered);
+
+    container::vector<std::string> words{"apple", "pear"};
+    container::vector<std::string> other{"apple", "plum"};
+    EXPECT_EQ(container::mismatch(words, other), 1);
+    EXPECT_LT(words, other);
+}
+
+TEST(VectorCompareTest, BitwiseComparableStruct) {
+    container::vector<Point> lhs{{1, 2}, {3, 4}}, rhs{{1, 2}, {3, 5}};
+    EXPECT_EQ(container::mismatch(lhs, rhs), 1);
+    EXPECT_LT(lhs, rhs);
+    rhs[1].y = 4;
+    EXPECT_EQ(lhs, rhs);
+}
+
+TEST(VectorCompareTest, BitwiseComparableWithoutThreeWay) {
+    container::vector<Version> lhs{{1}, {2}}, rhs{{1}, {3}};
+    EXPECT_EQ(lhs <=> rhs, std::weak_ordering::less);
+    EXPECT_EQ(rhs <=> lhs, std::weak_ordering::greater);
+    EXPECT_EQ(lhs <=> lhs, std::weak_ordering::equivalent);
+}
+
+namespace {
+struct alignas(64) Counter {
+    long value;
+};
+
+template <typename Vector>
+bool IsAligned(const Vector& vec, size_t alignment) {
+    return (uintptr_t)vec.data() % alignment == 0;
+}
+}  // namespace
+
+TEST(VectorAlignmentTest, OverAlignedElements) {
+    static_assert(!container::reallocating_allocator<
+                  container::malloc_allocator<Counter>, Counter>);
+    container::vector<Counter> vec;
+    for (long i = 0; i < 100; ++i) {
+        vec.push_back({i});
+        EXPECT_TRUE(IsAligned(vec, 64));
+    }
+    vec.resize(3);
+    vec.shrink_to_fit();
+    EXPECT_TRUE(IsAligned(vec, 64));
+    EXPECT_EQ(vec[2].value, 2);
+
+    container::small_vector<Counter, 2> small(2);
+    EXPECT_TRUE(IsAligned(small, 64));
+}
+
+TEST(VectorAlignmentTest, AlignedAllocator) {
+    container::vector<float, container::aligned_allocator<float, 64>> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+        EXPECT_TRUE(IsAligned(vec, 64));
+    }
+    // the alignment survives rebinding, e.g. for vector<bool>'s words
+    using Rebound = std::allocator_traits<container::aligned_allocator<
+        float, 64>>::rebind_alloc<char>;
+    EXPECT_EQ(Rebound::alignment, 64);
+}
+
+TEST(VectorAlignmentTest, CachePadded) {
+    static_assert(sizeof(container::cache_padded<int>) ==
+                  container::cache_line_size);
+    container::vector<container::cache_padded<int>> counters(4);
+    for (size_t i = 0; i < counters.size(); ++i) {
+        *counters[i] = i;
+        EXPECT_EQ((uintptr_t)&counters[i] % container::cache_line_size, 0);
+    }
+    EXPECT_EQ(*counters[3], 3);
+}
+
+TEST(VectorParallelTest, FillCopyAndResize) {
+    container::thread_pool pool(4);
+    container::parallel_t par(&pool);
+    const size_t n = (size_t(1) << 20) + 3;
+    container::vector<double> vec(n, 1.5, par);
+    // sized exactly, like the serial constructors
+    EXPECT_EQ(vec.capacity(), n);
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 1.5), n);
+    container::vector<double> copy(vec, par);
+    EXPECT_EQ(copy, vec);
+    copy.resize(n / 2, par);
+    copy.resize(n, 2.5, par);
+    EXPECT_EQ(copy[n / 2 - 1], 1.5);
+    EXPECT_EQ(copy[n / 2], 2.5);
+    copy.assign(n - 1, copy.back(), par);
+    EXPECT_EQ(std::count(copy.begin(), copy.end(), 2.5), n - 1);
+    container::vector<double> zeros(n, par);
+    EXPECT_EQ(zeros.capacity(), n);
+    EXPECT_EQ(std::count(zeros.begin(), zeros.end(), 0.0), n);
+}
+
+namespace {
+struct Counted {
+    static inline std::atomic<int> live = 0;
+    static inline std::atomic<int> copiesLeft = 0;
+    Counted() { ++live; }
+    Counted(const Counted&) {
+        if (--copiesLeft < 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++live;
+    }
+    ~Counted() { --live; }
+    long padding = 0;
+};
+}  // namespace
+
+TEST(VectorParallelTest, ThrowingSliceRollsBack) {
+    container::thread_pool pool(4);
+    container::parallel_t par(&pool);
+    const size_t n = size_t(1) << 20;
+    {
+        container::vector<Counted> vec(n, par);
+        EXPECT_EQ(Counted::live, n);
+        Counted::copiesLeft = n / 2;
+        EXPECT_THROW(container::vector<Counted>(vec, par),
+                     std::runtime_error);
+        EXPECT_EQ(Counted::live, n);
+        vec.clear(par);
+        EXPECT_EQ(Counted::live, 0);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+}  // namespace cpp::common::test